@@ -0,0 +1,452 @@
+/**********************************************************************************************
+*
+*   RLGameGUi * A game gui for raylib
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+#include "GUIDrawList.h"
+#include "rlText.h"
+
+#include <algorithm>
+
+namespace RLGameGUI
+{
+	static Rectangle NormalizeRect(const Rectangle& rect)
+	{
+		Rectangle normal = rect;
+		if (normal.width < 0)
+		{
+			normal.x += normal.width;
+			normal.width = -normal.width;
+		}
+		if (normal.height < 0)
+		{
+			normal.y += normal.height;
+			normal.height = -normal.height;
+		}
+		return normal;
+	}
+
+	static Rectangle MergeRect(const Rectangle& a, const Rectangle& b)
+	{
+		float minX = std::min(a.x, b.x);
+		float minY = std::min(a.y, b.y);
+		float maxX = std::max(a.x + a.width, b.x + b.width);
+		float maxY = std::max(a.y + a.height, b.y + b.height);
+		return Rectangle{ minX, minY, maxX - minX, maxY - minY };
+	}
+
+	void GUIDrawList::Clear()
+	{
+		Commands.clear();
+		Batches.clear();
+		Clips.clear();
+		ClipStack.clear();
+
+		// clip 0 is always the unclipped screen
+		Clips.emplace_back(Rectangle{ 0,0,0,0 });
+
+		Layer = 0;
+		LayerFirstBatch = 0;
+		Stats = DrawStats();
+	}
+
+	void GUIDrawList::SetLayer(int layer)
+	{
+		if (layer == Layer)
+			return;
+
+		Layer = layer;
+		LayerFirstBatch = Batches.size();
+	}
+
+	void GUIDrawList::PushClip(const Rectangle& rect)
+	{
+		Rectangle clip = NormalizeRect(rect);
+		if (!ClipStack.empty())
+		{
+			const Rectangle& parent = Clips[ClipStack.back()];
+			if (CheckCollisionRecs(parent, clip))
+				clip = GetCollisionRec(parent, clip);
+			else
+				clip = Rectangle{ clip.x, clip.y, 0, 0 };
+		}
+
+		ClipStack.push_back(int(Clips.size()));
+		Clips.push_back(clip);
+	}
+
+	void GUIDrawList::PopClip()
+	{
+		if (!ClipStack.empty())
+			ClipStack.pop_back();
+	}
+
+	void GUIDrawList::AddQuad(const Texture2D& texture, const Rectangle& source, const Rectangle& dest, Color tint, const Shader* shader)
+	{
+		if (texture.id == 0)
+			return;
+
+		Command command;
+		command.Texture = texture;
+		command.Source = source;
+		command.Dest = dest;
+		command.Tint = tint;
+		command.QuadShader = shader;
+		Add(command);
+	}
+
+	void GUIDrawList::AddRectangle(const Rectangle& rect, Color color)
+	{
+		Command command;
+		command.Dest = rect;
+		command.Tint = color;
+		command.Solid = true;
+		Add(command);
+	}
+
+	void GUIDrawList::AddRectangleLines(const Rectangle& rect, float thickness, Color color)
+	{
+		// same edges as DrawRectangleLinesEx
+		if (thickness > rect.width || thickness > rect.height)
+		{
+			if (rect.width > rect.height)
+				thickness = rect.height / 2;
+			else if (rect.width < rect.height)
+				thickness = rect.width / 2;
+		}
+
+		AddRectangle(Rectangle{ rect.x, rect.y, rect.width, thickness }, color);
+		AddRectangle(Rectangle{ rect.x, rect.y - thickness + rect.height, rect.width, thickness }, color);
+		AddRectangle(Rectangle{ rect.x, rect.y + thickness, thickness, rect.height - thickness * 2 }, color);
+		AddRectangle(Rectangle{ rect.x - thickness + rect.width, rect.y + thickness, thickness, rect.height - thickness * 2 }, color);
+	}
+
+	void GUIDrawList::AddNPatch(const Texture2D& texture, const NPatchInfo& info, const Rectangle& dest, Color tint)
+	{
+		if (texture.id == 0)
+			return;
+
+		// split into the same patches DrawTextureNPatch draws
+		Rectangle source = info.source;
+		if (source.width < 0)
+			source.x -= source.width;
+		if (source.height < 0)
+			source.y -= source.height;
+
+		float patchWidth = dest.width <= 0 ? 0 : dest.width;
+		float patchHeight = dest.height <= 0 ? 0 : dest.height;
+
+		if (info.layout == NPATCH_THREE_PATCH_HORIZONTAL)
+			patchHeight = source.height;
+		if (info.layout == NPATCH_THREE_PATCH_VERTICAL)
+			patchWidth = source.width;
+
+		bool drawCenter = true;
+		bool drawMiddle = true;
+		float leftBorder = float(info.left);
+		float topBorder = float(info.top);
+		float rightBorder = float(info.right);
+		float bottomBorder = float(info.bottom);
+
+		if (patchWidth <= leftBorder + rightBorder && info.layout != NPATCH_THREE_PATCH_VERTICAL)
+		{
+			drawCenter = false;
+			if (leftBorder + rightBorder > 0)
+				leftBorder = (leftBorder / (leftBorder + rightBorder)) * patchWidth;
+			rightBorder = patchWidth - leftBorder;
+		}
+		if (patchHeight <= topBorder + bottomBorder && info.layout != NPATCH_THREE_PATCH_HORIZONTAL)
+		{
+			drawMiddle = false;
+			if (topBorder + bottomBorder > 0)
+				topBorder = (topBorder / (topBorder + bottomBorder)) * patchHeight;
+			bottomBorder = patchHeight - topBorder;
+		}
+
+		float destX[4] = { dest.x, dest.x + leftBorder, dest.x + patchWidth - rightBorder, dest.x + patchWidth };
+		float destY[4] = { dest.y, dest.y + topBorder, dest.y + patchHeight - bottomBorder, dest.y + patchHeight };
+		float srcX[4] = { source.x, source.x + info.left, source.x + source.width - info.right, source.x + source.width };
+		float srcY[4] = { source.y, source.y + info.top, source.y + source.height - info.bottom, source.y + source.height };
+
+		auto addPatch = [&](int x0, int x1, int y0, int y1)
+			{
+				Rectangle patchDest = { destX[x0], destY[y0], destX[x1] - destX[x0], destY[y1] - destY[y0] };
+				if (patchDest.width <= 0 || patchDest.height <= 0)
+					return;
+
+				AddQuad(texture, Rectangle{ srcX[x0], srcY[y0], srcX[x1] - srcX[x0], srcY[y1] - srcY[y0] }, patchDest, tint);
+			};
+
+		if (info.layout == NPATCH_THREE_PATCH_HORIZONTAL)
+		{
+			addPatch(0, 1, 0, 3);
+			if (drawCenter)
+				addPatch(1, 2, 0, 3);
+			addPatch(2, 3, 0, 3);
+		}
+		else if (info.layout == NPATCH_THREE_PATCH_VERTICAL)
+		{
+			addPatch(0, 3, 0, 1);
+			if (drawMiddle)
+				addPatch(0, 3, 1, 2);
+			addPatch(0, 3, 2, 3);
+		}
+		else
+		{
+			for (int row = 0; row < 3; row++)
+			{
+				if (row == 1 && !drawMiddle)
+					continue;
+
+				for (int column = 0; column < 3; column++)
+				{
+					if (column == 1 && !drawCenter)
+						continue;
+
+					addPatch(column, column + 1, row, row + 1);
+				}
+			}
+		}
+	}
+
+	void GUIDrawList::Add(const Command& command)
+	{
+		Stats.Commands++;
+
+		Rectangle bounds = NormalizeRect(command.Dest);
+		int clip = ClipStack.empty() ? 0 : ClipStack.back();
+
+		if (command.Tint.a == 0 || bounds.width <= 0 || bounds.height <= 0 || (clip != 0 && !CheckCollisionRecs(bounds, Clips[clip])))
+		{
+			Stats.Culled++;
+			return;
+		}
+
+		int batchIndex = FindBatch(command, bounds);
+		if (batchIndex < 0)
+		{
+			Batch batch;
+			batch.TextureID = command.Texture.id;
+			batch.Solid = command.Solid;
+			batch.QuadShader = command.QuadShader;
+			batch.Clip = clip;
+			batch.Bounds = bounds;
+
+			batchIndex = int(Batches.size());
+			Batches.push_back(batch);
+		}
+		else
+		{
+			Batches[batchIndex].Bounds = MergeRect(Batches[batchIndex].Bounds, bounds);
+		}
+
+		Batches[batchIndex].Count++;
+
+		Commands.push_back(command);
+		Commands.back().Batch = batchIndex;
+	}
+
+	int GUIDrawList::FindBatch(const Command& command, const Rectangle& bounds) const
+	{
+		int clip = ClipStack.empty() ? 0 : ClipStack.back();
+
+		int first = std::max(int(LayerFirstBatch), int(Batches.size()) - MaxBatchSearch);
+		for (int i = int(Batches.size()) - 1; i >= first; i--)
+		{
+			const Batch& batch = Batches[i];
+			if (batch.Solid == command.Solid && batch.QuadShader == command.QuadShader && batch.TextureID == command.Texture.id && batch.Clip == clip)
+				return i;
+
+			// can't move in front of something we would draw over
+			if (CheckCollisionRecs(batch.Bounds, bounds))
+				return -1;
+		}
+
+		return -1;
+	}
+
+	void GUIDrawList::Submit()
+	{
+		if (Batches.empty())
+			return;
+
+		// bucket the commands by batch, keeping record order inside each one
+		int start = 0;
+		for (auto& batch : Batches)
+		{
+			batch.Start = start;
+			start += batch.Count;
+			batch.Count = 0;
+		}
+
+		CommandOrder.resize(Commands.size());
+		for (int i = 0; i < int(Commands.size()); i++)
+		{
+			Batch& batch = Batches[Commands[i].Batch];
+			CommandOrder[batch.Start + batch.Count++] = i;
+		}
+
+		const Batch* lastBatch = nullptr;
+		int currentClip = 0;
+		const Shader* currentShader = nullptr;
+
+		// batches never merge across layers, so creation order is already layer order
+		for (const Batch& batch : Batches)
+		{
+			if (batch.QuadShader != currentShader)
+			{
+				if (batch.QuadShader)
+					BeginShaderMode(*batch.QuadShader);
+				else
+					EndShaderMode();
+
+				currentShader = batch.QuadShader;
+			}
+
+			if (!lastBatch || lastBatch->Solid != batch.Solid || lastBatch->TextureID != batch.TextureID || lastBatch->QuadShader != batch.QuadShader)
+			{
+				if (lastBatch)
+					Stats.TextureSwitches++;
+				Stats.Batches++;
+			}
+			else if (lastBatch->Clip != batch.Clip)
+			{
+				Stats.Batches++;
+			}
+			lastBatch = &batch;
+
+			if (batch.Clip != currentClip)
+			{
+				if (currentClip != 0)
+					EndScissorMode();
+
+				currentClip = batch.Clip;
+				if (currentClip != 0)
+				{
+					const Rectangle& clip = Clips[currentClip];
+					BeginScissorMode(int(clip.x), int(clip.y), int(clip.width), int(clip.height));
+				}
+			}
+
+			for (int i = batch.Start; i < batch.Start + batch.Count; i++)
+			{
+				const Command& command = Commands[CommandOrder[i]];
+				if (command.Solid)
+					DrawRectangleRec(command.Dest, command.Tint);
+				else
+					DrawTexturePro(command.Texture, command.Source, command.Dest, Vector2{ 0,0 }, 0, command.Tint);
+			}
+		}
+
+		if (currentClip != 0)
+			EndScissorMode();
+
+		if (currentShader)
+			EndShaderMode();
+	}
+
+	namespace Renderer
+	{
+		static GUIDrawList* ActiveList = nullptr;
+
+		static void RecordGlyph(const Texture2D& texture, const Rectangle& source, const Rectangle& dest, Color tint, const Shader* shader)
+		{
+			ActiveList->AddQuad(texture, source, dest, tint, shader);
+		}
+
+		void Begin(GUIDrawList* list)
+		{
+			ActiveList = list;
+			rltSetGlyphDrawFunction(list ? RecordGlyph : nullptr);
+		}
+
+		void End()
+		{
+			Begin(nullptr);
+		}
+
+		GUIDrawList* GetDrawList()
+		{
+			return ActiveList;
+		}
+
+		void DrawTexture(const Texture2D& texture, const Rectangle& source, const Rectangle& dest, Color tint)
+		{
+			// textures still loading have no id yet
+			if (texture.id == 0)
+				return;
+
+			if (ActiveList)
+				ActiveList->AddQuad(texture, source, dest, tint);
+			else
+				DrawTexturePro(texture, source, dest, Vector2{ 0,0 }, 0, tint);
+		}
+
+		void DrawRectangle(const Rectangle& rect, Color color)
+		{
+			if (ActiveList)
+				ActiveList->AddRectangle(rect, color);
+			else
+				DrawRectangleRec(rect, color);
+		}
+
+		void DrawRectangleLines(const Rectangle& rect, float thickness, Color color)
+		{
+			if (ActiveList)
+				ActiveList->AddRectangleLines(rect, thickness, color);
+			else
+				DrawRectangleLinesEx(rect, thickness, color);
+		}
+
+		void DrawTextureNPatch(const Texture2D& texture, const NPatchInfo& info, const Rectangle& dest, Color tint)
+		{
+			if (texture.id == 0)
+				return;
+
+			if (ActiveList)
+				ActiveList->AddNPatch(texture, info, dest, tint);
+			else
+				::DrawTextureNPatch(texture, info, dest, Vector2{ 0,0 }, 0, tint);
+		}
+
+		void BeginClip(const Rectangle& rect)
+		{
+			if (ActiveList)
+				ActiveList->PushClip(rect);
+			else
+				BeginScissorMode(int(rect.x), int(rect.y), int(rect.width), int(rect.height));
+		}
+
+		void EndClip()
+		{
+			if (ActiveList)
+				ActiveList->PopClip();
+			else
+				EndScissorMode();
+		}
+	}
+}
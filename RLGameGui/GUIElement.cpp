@@ -29,21 +29,49 @@
 #include "GUIElement.h"
 #include "GUIScreenIO.h"
 
+#include <algorithm>
+
 using namespace rapidjson;
 
 namespace RLGameGUI
 {
 	void GUIElement::Update(Vector2 mousePostion)
 	{
-		OnPreUpdate();
+		UpdateTree(mousePostion, 0);
+	}
 
-        if (RelativeBounds.IsDirty())
-            Resize();
+	void GUIElement::UpdateTree(Vector2 mousePostion, uint32_t hitFrame)
+	{
+		OnPreUpdate();
 
 		if (Disabled)
 			mousePostion.x = -1;
 
-		if (mousePostion.x < 0 || !CheckCollisionPointRec(mousePostion, GetScreenRect()))
+		if (hitFrame == 0)
+		{
+			ProcessPointer(mousePostion.x >= 0 && CheckCollisionPointRec(mousePostion, GetScreenRect()));
+		}
+		else
+		{
+			// the screen already found the elements under the pointer, only they and the ones that need to end a hover or click are touched
+			bool candidate = PointerCandidateFrame == hitFrame;
+			if (candidate || Hovered || Clicked)
+				ProcessPointer(mousePostion.x >= 0 && candidate);
+		}
+
+		OnUpdate();
+        if (RelativeBounds.IsDirty())
+            InvalidateLayout();
+
+		for (auto child : Children)
+			child->UpdateTree(mousePostion, hitFrame);
+
+		OnPostChildUpdate();
+	}
+
+	void GUIElement::ProcessPointer(bool inside)
+	{
+		if (!inside)
 		{
 			if (Hovered)
 			{
@@ -82,19 +110,24 @@ namespace RLGameGUI
 					ElementClicked(this);
 			}
 		}
+	}
 
-		OnUpdate();
-        if (RelativeBounds.IsDirty())
-            Resize();
+	size_t GUIElement::Resize()
+	{
+		ResizeSelf();
 
-		for (auto child : Children)
-			child->Update(mousePostion);
+		size_t resolved = 1;
+        for (auto child : Children)
+            resolved += child->Resize();
 
-		OnPostChildUpdate();
+		return resolved;
 	}
 
-	void GUIElement::Resize()
+	void GUIElement::ResizeSelf()
 	{
+		LayoutDirty = false;
+		ChildLayoutDirty = false;
+
 		OnPreResize();
 
 		Vector2 padding = { 0,0 };
@@ -111,17 +144,87 @@ namespace RLGameGUI
 		ContentRect.height -= padding.y * 2;
 
         OnResize();
-        for (auto child : Children)
-            child->Resize();
+	}
+
+	void GUIElement::InvalidateLayout()
+	{
+		LayoutDirty = true;
+
+		// ancestors only need to know that something below them is dirty, stop at the first one that already does
+		for (GUIElement* parent = Parent; parent != nullptr && !parent->ChildLayoutDirty; parent = parent->Parent)
+			parent->ChildLayoutDirty = true;
 	}
 
     GUIElement::Ptr GUIElement::AddChild(GUIElement::Ptr child)
     {
 		child->Parent = this;
 		Children.emplace_back(child);
+		child->InvalidateLayout();
+		OnTreeChanged();
 		return child;
     }
 
+	void GUIElement::RemoveChild(GUIElement::Ptr child)
+	{
+		auto itr = std::find(Children.begin(), Children.end(), child);
+		if (itr == Children.end())
+			return;
+
+		OnSubtreeRemoved(child.get());
+
+		child->Parent = nullptr;
+		Children.erase(itr);
+		InvalidateLayout();
+		OnTreeChanged();
+	}
+
+	void GUIElement::OnTreeChanged()
+	{
+		if (Parent)
+			Parent->OnTreeChanged();
+	}
+
+	void GUIElement::OnSubtreeRemoved(GUIElement* root)
+	{
+		if (Parent)
+			Parent->OnSubtreeRemoved(root);
+	}
+
+	void GUIElement::RequestUpdate()
+	{
+		OnUpdateRequested();
+	}
+
+	void GUIElement::OnUpdateRequested()
+	{
+		if (Parent)
+			Parent->OnUpdateRequested();
+	}
+
+	void GUIElement::SetRelativeBounds(const RelativeRect& bounds)
+	{
+		RelativeBounds = bounds;
+		InvalidateLayout();
+	}
+
+	void GUIElement::SetHidden(bool hidden)
+	{
+		if (Hidden == hidden)
+			return;
+
+		Hidden = hidden;
+		RequestUpdate();
+	}
+
+	void GUIElement::SetDisabled(bool disabled)
+	{
+		if (Disabled == disabled)
+			return;
+
+		Disabled = disabled;
+		RequestUpdate();
+	}
+
     void GUIElement::Render()
 	{
 		if (Hidden)
@@ -139,17 +242,11 @@ namespace RLGameGUI
 
 	const Rectangle& GUIElement::GetScreenRect()
 	{
-        if (RelativeBounds.IsDirty())
-            Resize();
-
 		return ScreenRect;
 	}
 
 	const Rectangle& GUIElement::GetContentRect()
 	{
-        if (RelativeBounds.IsDirty())
-            Resize();
-
         return ContentRect;
 	}
 
@@ -0,0 +1,166 @@
+/**********************************************************************************************
+*
+*   RLGameGUi * A game gui for raylib
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+#include "GUIHitGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace RLGameGUI
+{
+	void GUIHitGrid::Reset(const Rectangle& bounds)
+	{
+		Clear();
+
+		Bounds = bounds;
+		Columns = std::max(1, int(std::ceil(bounds.width / CellSize)));
+		Rows = std::max(1, int(std::ceil(bounds.height / CellSize)));
+		Cells.resize(size_t(Columns * Rows));
+	}
+
+	void GUIHitGrid::Clear()
+	{
+		Cells.clear();
+		Overflow.clear();
+		Entries.clear();
+		Columns = 0;
+		Rows = 0;
+	}
+
+	void GUIHitGrid::Update(GUIElement* element, const Rectangle& rect)
+	{
+		auto itr = Entries.find(element);
+		if (itr == Entries.end())
+		{
+			itr = Entries.emplace(element, Entry()).first;
+		}
+		else
+		{
+			const Rectangle& old = itr->second.Rect;
+			if (old.x == rect.x && old.y == rect.y && old.width == rect.width && old.height == rect.height)
+				return;
+
+			Unlink(element, itr->second);
+		}
+
+		itr->second.Rect = rect;
+		Insert(element, itr->second);
+	}
+
+	void GUIHitGrid::Remove(GUIElement* element)
+	{
+		auto itr = Entries.find(element);
+		if (itr == Entries.end())
+			return;
+
+		Unlink(element, itr->second);
+		Entries.erase(itr);
+	}
+
+	void GUIHitGrid::Query(Vector2 point, std::vector<GUIElement*>& results) const
+	{
+		for (GUIElement* element : Overflow)
+		{
+			if (CheckCollisionPointRec(point, Entries.at(element).Rect))
+				results.push_back(element);
+		}
+
+		if (Cells.empty() || point.x < Bounds.x || point.y < Bounds.y)
+			return;
+
+		int x = int((point.x - Bounds.x) / CellSize);
+		int y = int((point.y - Bounds.y) / CellSize);
+		if (x >= Columns || y >= Rows)
+			return;
+
+		for (GUIElement* element : Cells[size_t(y * Columns + x)])
+		{
+			if (CheckCollisionPointRec(point, Entries.at(element).Rect))
+				results.push_back(element);
+		}
+	}
+
+	void GUIHitGrid::Insert(GUIElement* element, Entry& entry)
+	{
+		const Rectangle& rect = entry.Rect;
+
+		entry.MaxX = entry.MaxY = -1;
+		entry.Overflow = false;
+
+		if (rect.width <= 0 || rect.height <= 0 || Cells.empty())
+			return;
+
+		float right = rect.x + rect.width;
+		float bottom = rect.y + rect.height;
+
+		if (rect.x < Bounds.x || rect.y < Bounds.y || right > Bounds.x + Bounds.width || bottom > Bounds.y + Bounds.height)
+		{
+			// anything not fully inside the grid is tested every query, there are rarely more than a few
+			entry.Overflow = true;
+			Overflow.push_back(element);
+			return;
+		}
+
+		entry.MinX = int((rect.x - Bounds.x) / CellSize);
+		entry.MinY = int((rect.y - Bounds.y) / CellSize);
+		entry.MaxX = std::min(Columns - 1, int((right - Bounds.x) / CellSize));
+		entry.MaxY = std::min(Rows - 1, int((bottom - Bounds.y) / CellSize));
+
+		for (int y = entry.MinY; y <= entry.MaxY; y++)
+		{
+			for (int x = entry.MinX; x <= entry.MaxX; x++)
+				Cells[size_t(y * Columns + x)].push_back(element);
+		}
+	}
+
+	void GUIHitGrid::Unlink(GUIElement* element, Entry& entry)
+	{
+		if (entry.Overflow)
+			EraseFrom(Overflow, element);
+
+		for (int y = entry.MinY; y <= entry.MaxY; y++)
+		{
+			for (int x = entry.MinX; x <= entry.MaxX; x++)
+				EraseFrom(Cells[size_t(y * Columns + x)], element);
+		}
+
+		entry.MaxX = entry.MaxY = -1;
+		entry.Overflow = false;
+	}
+
+	void GUIHitGrid::EraseFrom(std::vector<GUIElement*>& list, GUIElement* element)
+	{
+		auto itr = std::find(list.begin(), list.end(), element);
+		if (itr == list.end())
+			return;
+
+		*itr = list.back();
+		list.pop_back();
+	}
+}
@@ -27,6 +27,8 @@
 **********************************************************************************************/
 
 #include "GUIManager.h"
+#include "GUITextureManager.h"
+#include "rlText.h"
 
 #include <stack>
 
@@ -39,6 +41,10 @@ namespace RLGameGUI
 		void Update()
 		{
 			auto top = TopScreen();
+
+			// elements sized from a texture that just arrived invalidate their own layout the next time they ask for it
+			TextureManager::ProcessLoads();
+
 			if (top != nullptr)
 				top->Update();
 		}
@@ -50,6 +56,12 @@ namespace RLGameGUI
 				return;
 
 			top->Render();
+
+			// everything this frame drew has been submitted, so its cached glyphs can be evicted again
+			rltNextGlyphCacheFrame();
+
+			// and textures it did not draw can be evicted
+			TextureManager::NextFrame();
 		}
 		
 		void PushScreen(GUIScreen::Ptr screen)
@@ -0,0 +1,73 @@
+/**********************************************************************************************
+*
+*   RLGameGUi * A game gui for raylib
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+#include "GUINodeStore.h"
+#include "GUIElement.h"
+
+namespace RLGameGUI
+{
+	void GUINodeStore::Build(GUIElement* root)
+	{
+		Clear();
+
+		if (root != nullptr)
+			AddNode(root, -1);
+	}
+
+	void GUINodeStore::Clear()
+	{
+		Elements.clear();
+		Parents.clear();
+		SubtreeEnds.clear();
+		ScreenRects.clear();
+		Flags.clear();
+	}
+
+	void GUINodeStore::SyncRects(int node)
+	{
+		ScreenRects[node] = Elements[node]->GetScreenRect();
+	}
+
+	int GUINodeStore::AddNode(GUIElement* element, int parent)
+	{
+		int node = Size();
+
+		Elements.push_back(element);
+		Parents.push_back(parent);
+		SubtreeEnds.push_back(node + 1);
+		ScreenRects.push_back(element->GetScreenRect());
+		Flags.push_back(0);
+
+		for (auto& child : element->Children)
+			AddNode(child.get(), node);
+
+		SubtreeEnds[node] = Size();
+		return node;
+	}
+}
@@ -39,6 +39,7 @@ namespace RLGameGUI
 	void GUIScreen::Activate()
 	{
 		Active = true;
+		UpdateRequested = true;
 		DoResize();
 		OnActivate();
 	}
@@ -51,46 +52,379 @@ namespace RLGameGUI
 
 	void GUIScreen::DoResize()
     {
-        Resize();
-        for (auto child : Children)
-            child->Resize();
+		InvalidateLayout();
+		DoLayout();
 	}
 
-	void GUIScreen::Update()
+	void GUIScreen::DoLayout()
 	{
-		for (auto& [layer, callbacks] : PostRenderCallbacks)
+		if (!UseHitGrid)
+			HitGridDirty = true;
+
+		if (!NeedsLayout())
+			return;
+
+		// the screen itself changing size moves the grid bounds
+		if (LayoutDirty)
+			HitGridDirty = true;
+
+		// single top down pass, only dirty branches are visited and each dirty subtree is resolved once
+		if (UseNodeStore)
 		{
-			callbacks.clear();
+			BuildNodeStore();
+			Stats.ResolvedNodes += ResolveNodeLayout();
+		}
+		else
+		{
+			Stats.ResolvedNodes += ResolveTreeLayout();
+		}
+		Stats.LayoutPasses++;
+
+		// moved elements may have changed what is under a pointer that did not move
+		UpdateRequested = true;
+	}
+
+	bool GUIScreen::IsIdle(Vector2 mousePosition, bool mouseDown) const
+	{
+		if (!SkipIdleUpdates || UpdateRequested || NeedsLayout())
+			return false;
+
+		return mouseDown == LastMouseDown && mousePosition.x == LastMousePosition.x && mousePosition.y == LastMousePosition.y;
+	}
+
+	void GUIScreen::CollectLayoutRoots(GUIElement* element)
+	{
+		if (element->LayoutDirty)
+		{
+			LayoutRoots.push_back(element);
+			return;
+		}
+
+		if (!element->ChildLayoutDirty)
+			return;
+
+		element->ChildLayoutDirty = false;
+		for (auto& child : element->Children)
+			CollectLayoutRoots(child.get());
+	}
+
+	size_t GUIScreen::ResolveTreeLayout()
+	{
+		LayoutRoots.clear();
+		CollectLayoutRoots(this);
+
+		size_t resolved = 0;
+		for (GUIElement* root : LayoutRoots)
+		{
+			resolved += root->Resize();
+
+			if (UseHitGrid && !HitGridDirty)
+				IndexSubtree(root);
+		}
+
+		return resolved;
+	}
+
+	void GUIScreen::RebuildHitGrid()
+	{
+		HitGrid.Reset(GetScreenRect());
+
+		if (UseNodeStore)
+		{
+			BuildNodeStore();
+			for (int node = 1; node < NodeStore.Size(); node++)
+				HitGrid.Update(NodeStore.Elements[node], NodeStore.ScreenRects[node]);
+		}
+		else
+		{
+			for (auto& child : Children)
+				IndexSubtree(child.get());
+		}
+
+		HitGridDirty = false;
+	}
+
+	void GUIScreen::IndexSubtree(GUIElement* element)
+	{
+		if (element != this)
+			HitGrid.Update(element, element->GetScreenRect());
+
+		for (auto& child : element->Children)
+			IndexSubtree(child.get());
+	}
+
+	void GUIScreen::UnindexSubtree(GUIElement* element)
+	{
+		HitGrid.Remove(element);
+
+		for (auto& child : element->Children)
+			UnindexSubtree(child.get());
+	}
+
+	void GUIScreen::OnSubtreeRemoved(GUIElement* root)
+	{
+		if (!HitGridDirty)
+			UnindexSubtree(root);
+	}
+
+	uint32_t GUIScreen::FindPointerCandidates(Vector2 mousePosition)
+	{
+		if (HitGridDirty)
+			RebuildHitGrid();
+
+		// candidates are stamped with the frame instead of flagged, so nothing has to be cleared and removed elements are never touched
+		HitFrame++;
+		if (HitFrame == 0)
+			HitFrame = 1;
+
+		HitCandidates.clear();
+		if (mousePosition.x >= 0)
+			HitGrid.Query(mousePosition, HitCandidates);
+
+		for (GUIElement* element : HitCandidates)
+			element->PointerCandidateFrame = HitFrame;
+
+		Stats.PointerCandidates = HitCandidates.size();
+		return HitFrame;
+	}
+
+	void GUIScreen::BuildNodeStore()
+	{
+		if (!NodeStoreDirty)
+			return;
+
+		NodeStore.Build(this);
+		NodeStoreDirty = false;
+	}
+
+	size_t GUIScreen::ResolveNodeLayout()
+	{
+		size_t resolved = 0;
+
+		int count = NodeStore.Size();
+		for (int node = 0; node < count;)
+		{
+			GUIElement* element = NodeStore.Elements[node];
+
+			if (element->LayoutDirty)
+			{
+				// pre-order means every parent is resolved before its children
+				int end = NodeStore.SubtreeEnds[node];
+				for (int child = node; child < end; child++)
+				{
+					NodeStore.Elements[child]->ResizeSelf();
+					NodeStore.SyncRects(child);
+
+					if (UseHitGrid && !HitGridDirty && child > 0)
+						HitGrid.Update(NodeStore.Elements[child], NodeStore.ScreenRects[child]);
+				}
+
+				resolved += size_t(end - node);
+				node = end;
+			}
+			else if (element->ChildLayoutDirty)
+			{
+				element->ChildLayoutDirty = false;
+				node++;
+			}
+			else
+			{
+				node = NodeStore.SubtreeEnds[node];
+			}
+		}
+
+		return resolved;
+	}
+
+	void GUIScreen::UpdateNodes(Vector2 mousePosition, uint32_t hitFrame)
+	{
+		NodeWalkStack.clear();
+
+		NodeStore.Flags[0] = mousePosition.x < 0 ? GUINodeStore::InputBlocked : 0;
+
+		// any callback can add or remove elements, which may free nodes later in the store or on the walk stack
+		// so the walk stops as soon as the tree changes, the tree change requests an update that walks a rebuilt store next frame
+		int count = NodeStore.Size();
+		for (int node = 1; node < count; node++)
+		{
+			while (!NodeWalkStack.empty() && NodeWalkStack.back().first <= node && !NodeStoreDirty)
+			{
+				NodeWalkStack.back().second->OnPostChildUpdate();
+				NodeWalkStack.pop_back();
+			}
+			if (NodeStoreDirty)
+				break;
+
+			GUIElement* element = NodeStore.Elements[node];
+			element->OnPreUpdate();
+			if (NodeStoreDirty)
+				break;
+
+			bool blocked = element->Disabled || (NodeStore.Flags[NodeStore.Parents[node]] & GUINodeStore::InputBlocked) != 0;
+			if (hitFrame == 0)
+			{
+				element->ProcessPointer(!blocked && CheckCollisionPointRec(mousePosition, NodeStore.ScreenRects[node]));
+			}
+			else
+			{
+				bool candidate = element->PointerCandidateFrame == hitFrame;
+				if (candidate || element->Hovered || element->Clicked)
+					element->ProcessPointer(!blocked && candidate);
+			}
+			if (NodeStoreDirty)
+				break;
+
+			element->OnUpdate();
+			if (NodeStoreDirty)
+				break;
+
+			if (element->RelativeBounds.IsDirty())
+				element->InvalidateLayout();
+
+			NodeStore.Flags[node] = blocked ? GUINodeStore::InputBlocked : 0;
+
+			NodeWalkStack.emplace_back(NodeStore.SubtreeEnds[node], element);
+		}
+
+		while (!NodeWalkStack.empty() && !NodeStoreDirty)
+		{
+			NodeWalkStack.back().second->OnPostChildUpdate();
+			NodeWalkStack.pop_back();
+		}
+		NodeWalkStack.clear();
+	}
+
+	void GUIScreen::RenderNodes()
+	{
+		NodeWalkStack.clear();
+
+		// same as UpdateNodes, an element that changes the tree while drawing ends the walk, the next frame draws the new tree
+		int count = NodeStore.Size();
+		for (int node = 1; node < count && !NodeStoreDirty;)
+		{
+			while (!NodeWalkStack.empty() && NodeWalkStack.back().first <= node && !NodeStoreDirty)
+			{
+				NodeWalkStack.back().second->OnPostRender();
+				NodeWalkStack.pop_back();
+			}
+			if (NodeStoreDirty)
+				break;
+
+			GUIElement* element = NodeStore.Elements[node];
+			if (element->Hidden)
+			{
+				node = NodeStore.SubtreeEnds[node];
+				continue;
+			}
+
+			if (element->Renders)
+			{
+				element->OnRender();
+				NodeWalkStack.emplace_back(NodeStore.SubtreeEnds[node], element);
+			}
+			node++;
+		}
+
+		while (!NodeWalkStack.empty() && !NodeStoreDirty)
+		{
+			NodeWalkStack.back().second->OnPostRender();
+			NodeWalkStack.pop_back();
 		}
+		NodeWalkStack.clear();
+	}
+
+	void GUIScreen::Update()
+	{
+		Stats = FrameStats();
 
 		if (IsWindowResized())
 			DoResize();
 
 		// do input
 		Vector2 mouse = GetMousePosition();
+		bool mouseDown = IsMouseButtonDown(MOUSE_LEFT_BUTTON);
+
+		if (IsIdle(mouse, mouseDown))
+		{
+			// nothing could change hover or click state, keep last frame's post render callbacks too
+			Stats.UpdateSkipped = true;
+			SkippedUpdates++;
+			return;
+		}
+
+		UpdateRequested = false;
+		LastMousePosition = mouse;
+		LastMouseDown = mouseDown;
+
+		for (auto& [layer, callbacks] : PostRenderCallbacks)
+		{
+			callbacks.clear();
+		}
+
+		uint32_t hitFrame = 0;
+		if (UseHitGrid)
+			hitFrame = FindPointerCandidates(mouse);
 
 		// let everyone think
-		for (auto child : Children)
-			child->Update(mouse);
+		if (UseNodeStore)
+		{
+			BuildNodeStore();
+			UpdateNodes(mouse, hitFrame);
+		}
+		else
+		{
+			for (auto child : Children)
+				child->UpdateTree(mouse, hitFrame);
+		}
+
+		DoLayout();
 	}
 
 	void GUIScreen::Render()
 	{
+		// pick up anything that was changed between update and render
+		DoLayout();
+
+		if (UseDrawList)
+		{
+			DrawList.Clear();
+			Renderer::Begin(&DrawList);
+		}
+
 		OnRender();
-        for (auto child : Children)
-            child->Render();
+		if (UseNodeStore)
+		{
+			BuildNodeStore();
+			RenderNodes();
+		}
+		else
+		{
+			for (auto child : Children)
+				child->Render();
+		}
 
 		for (auto& [layer, callbacks] : PostRenderCallbacks)
 		{
+			if (UseDrawList)
+				DrawList.SetLayer(layer);
+
 			for (auto& callback : callbacks)
 				callback();
 		}
+
+		if (UseDrawList)
+		{
+			Renderer::End();
+			DrawList.Submit();
+		}
 	}
 
     GUIElement::Ptr GUIScreen::AddElement(GUIElement::Ptr element)
     {
 		element->Parent = this;
 		Children.emplace_back(element);
+		element->InvalidateLayout();
+		OnTreeChanged();
 		OnElementAdd(element);
 
 		return element;
@@ -1,8 +1,20 @@
 #include "GUITextureManager.h"
 
 #include "rlText.h"
+#include "GUIElement.h"
 
 #include <unordered_map>
+#include <string>
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// decoded on the worker threads, raylib's LoadImage goes through its file callbacks and trace log which are not thread safe
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include "external/stb_image.h"
 
 namespace RLGameGUI
 {
@@ -10,7 +22,107 @@ namespace RLGameGUI
     {
         std::string ResourceDir;
 
-        std::unordered_map<std::string, Texture2D> TextureCache;
+        std::unordered_map<std::string, TextureHandle> TextureCache;
+
+        TextureStats Stats;
+
+        size_t MemoryBudget = 0;
+        uint64_t Frame = 1;
+
+        bool AsyncLoading = false;
+        int WorkerThreads = 0;
+
+        size_t UploadBytesPerFrame = 4 * 1024 * 1024;
+        double UploadSecondsPerFrame = 0;
+
+        // only touches the file and stb_image, so it is safe off the main thread
+        // null data for files stb_image can not read, ProcessLoads hands those to raylib on the main thread
+        Image DecodeImage(const std::string& filePath)
+        {
+            Image image = { 0 };
+
+            int channels = 0;
+            image.data = stbi_load(filePath.c_str(), &image.width, &image.height, &channels, 0);
+            if (!image.data)
+                return image;
+
+            image.mipmaps = 1;
+            switch (channels)
+            {
+            case 1: image.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE; break;
+            case 2: image.format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA; break;
+            case 3: image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8; break;
+            default: image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8; break;
+            }
+
+            return image;
+        }
+
+        // file reads and image decodes run on these, GPU uploads stay on the main thread
+        struct LoadWorkers
+        {
+            std::vector<std::thread> Threads;
+            std::mutex Mutex;
+            std::condition_variable Signal;
+            bool Stopping = false;
+
+            std::deque<std::pair<std::string, std::string>> Requests;  // name and file path
+            std::deque<std::pair<std::string, Image>> Decoded;
+            size_t Decoding = 0;
+
+            ~LoadWorkers()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(Mutex);
+                    Stopping = true;
+                }
+                Signal.notify_all();
+
+                for (auto& thread : Threads)
+                    thread.join();
+
+                for (auto& [name, image] : Decoded)
+                    UnloadImage(image);
+            }
+
+            void Run()
+            {
+                while (true)
+                {
+                    std::pair<std::string, std::string> request;
+                    {
+                        std::unique_lock<std::mutex> lock(Mutex);
+                        Signal.wait(lock, [this]() { return Stopping || !Requests.empty(); });
+                        if (Stopping)
+                            return;
+
+                        request = std::move(Requests.front());
+                        Requests.pop_front();
+                        Decoding++;
+                    }
+
+                    Image image = DecodeImage(request.second);
+
+                    std::lock_guard<std::mutex> lock(Mutex);
+                    Decoded.emplace_back(std::move(request.first), image);
+                    Decoding--;
+                }
+            }
+
+            void Start(int count)
+            {
+                if (!Threads.empty())
+                    return;
+
+                if (count <= 0)
+                    count = std::max(1, int(std::thread::hardware_concurrency()));
+
+                for (int i = 0; i < count; i++)
+                    Threads.emplace_back(&LoadWorkers::Run, this);
+            }
+        };
+
+        LoadWorkers Workers;
 
         Texture2D LoadTexture(const std::string& name)
         {
@@ -19,26 +131,228 @@ namespace RLGameGUI
             return ::LoadTexture(filePath.c_str());
         }
 
+        void SetLoaded(TextureEntry& entry, Texture2D texture)
+        {
+            entry.Texture = texture;
+            entry.State = TextureEntry::States::Loaded;
+
+            if (texture.id == 0)
+                return;
+
+            entry.Bytes = size_t(GetPixelDataSize(texture.width, texture.height, texture.format));
+            Stats.Loaded++;
+            Stats.Bytes += entry.Bytes;
+        }
+
+        void Unload(TextureEntry& entry)
+        {
+            if (entry.Texture.id != 0)
+            {
+                UnloadTexture(entry.Texture);
+                Stats.Loaded--;
+                Stats.Bytes -= entry.Bytes;
+            }
+
+            entry.Texture = Texture2D{ 0 };
+            entry.Bytes = 0;
+            entry.State = TextureEntry::States::Unloaded;
+        }
+
         void SetResourceDir(const std::string& folderPath)
         {
             ResourceDir = folderPath;
         }
 
-        Texture2D GetTexture(const std::string& name)
+        void SetAsyncLoading(bool enabled, int workerThreads)
+        {
+            AsyncLoading = enabled;
+            WorkerThreads = workerThreads;
+        }
+
+        void SetUploadBudget(size_t bytesPerFrame, double secondsPerFrame)
+        {
+            UploadBytesPerFrame = bytesPerFrame;
+            UploadSecondsPerFrame = secondsPerFrame;
+        }
+
+        void RequestLoad(TextureEntry& entry)
+        {
+            if (!AsyncLoading)
+            {
+                SetLoaded(entry, LoadTexture(entry.Name));
+                return;
+            }
+
+            // the loading state keeps the name from being requested again, ProcessLoads fills it in
+            entry.State = TextureEntry::States::Loading;
+
+            Workers.Start(WorkerThreads);
+            {
+                std::lock_guard<std::mutex> lock(Workers.Mutex);
+                Workers.Requests.emplace_back(entry.Name, ResourceDir + "/" + entry.Name);
+            }
+            Workers.Signal.notify_one();
+        }
+
+        TextureHandle AcquireTexture(const std::string& name)
         {
             auto itr = TextureCache.find(name);
             if (itr == TextureCache.end())
-                itr = TextureCache.insert_or_assign(name, LoadTexture(name)).first;
+            {
+                auto entry = std::make_shared<TextureEntry>();
+                entry->Name = name;
+                itr = TextureCache.insert_or_assign(name, entry).first;
+            }
 
             return itr->second;
         }
 
+        Texture2D GetTexture(const TextureHandle& handle)
+        {
+            if (!handle)
+                return Texture2D{ 0 };
+
+            handle->LastUsedFrame = Frame;
+
+            // only unheld textures are evicted, so one coming back is like a first load and may go through the workers too
+            if (handle->State == TextureEntry::States::Evicted)
+                Stats.Reloads++;
+
+            if (handle->State == TextureEntry::States::Unloaded || handle->State == TextureEntry::States::Evicted)
+                RequestLoad(*handle);
+
+            return handle->Texture;
+        }
+
+        Texture2D GetTexture(const std::string& name)
+        {
+            // the caller keeps the raw texture without a handle, so it must never be evicted from under them
+            TextureHandle handle = AcquireTexture(name);
+            handle->Pinned = true;
+
+            return GetTexture(handle);
+        }
+
+        size_t ProcessLoads()
+        {
+            double startTime = GetTime();
+            size_t uploadedBytes = 0;
+            size_t uploaded = 0;
+
+            while (true)
+            {
+                std::pair<std::string, Image> decoded;
+                size_t bytes = 0;
+                {
+                    std::lock_guard<std::mutex> lock(Workers.Mutex);
+                    if (Workers.Decoded.empty())
+                        break;
+
+                    const Image& next = Workers.Decoded.front().second;
+                    bytes = next.data ? size_t(GetPixelDataSize(next.width, next.height, next.format)) : 0;
+                    if (uploaded > 0 && uploadedBytes + bytes > UploadBytesPerFrame)
+                        break;
+
+                    decoded = std::move(Workers.Decoded.front());
+                    Workers.Decoded.pop_front();
+                }
+
+                // UnloadAll may have dropped the request while it was decoding, only what reaches the GPU counts against the budget
+                auto itr = TextureCache.find(decoded.first);
+                if (itr != TextureCache.end() && itr->second->State == TextureEntry::States::Loading)
+                {
+                    // formats stb_image does not read go through raylib here, a file neither can read is an empty texture like a failed synchronous load
+                    SetLoaded(*itr->second, decoded.second.data ? LoadTextureFromImage(decoded.second) : LoadTexture(decoded.first));
+                    uploadedBytes += bytes;
+                    uploaded++;
+                }
+                UnloadImage(decoded.second);
+
+                if (UploadSecondsPerFrame > 0 && GetTime() - startTime >= UploadSecondsPerFrame)
+                    break;
+            }
+
+            return uploaded;
+        }
+
+        size_t GetPendingLoads()
+        {
+            std::lock_guard<std::mutex> lock(Workers.Mutex);
+            return Workers.Requests.size() + Workers.Decoding + Workers.Decoded.size();
+        }
+
         void UnloadAll()
         {
-            for (auto& [key, texture] : TextureCache)
-                UnloadTexture(texture);
+            {
+                std::lock_guard<std::mutex> lock(Workers.Mutex);
+                Workers.Requests.clear();
+
+                for (auto& [name, image] : Workers.Decoded)
+                    UnloadImage(image);
+                Workers.Decoded.clear();
+            }
+
+            for (auto itr = TextureCache.begin(); itr != TextureCache.end();)
+            {
+                Unload(*itr->second);
+
+                // held entries stay so their handles keep working
+                if (itr->second.use_count() == 1)
+                    itr = TextureCache.erase(itr);
+                else
+                    ++itr;
+            }
+        }
+
+        void SetMemoryBudget(size_t bytes)
+        {
+            MemoryBudget = bytes;
+        }
+
+        void NextFrame()
+        {
+            if (MemoryBudget > 0 && Stats.Bytes > MemoryBudget)
+            {
+                // only textures nothing holds, the cache's own reference is the only one they have
+                // held textures are on a screen and would have to reload the moment they are drawn again
+                std::vector<TextureEntry*> candidates;
+                for (auto& [name, entry] : TextureCache)
+                {
+                    if (entry->Texture.id != 0 && !entry->Pinned && entry.use_count() == 1 && entry->LastUsedFrame < Frame)
+                        candidates.push_back(entry.get());
+                }
+
+                std::sort(candidates.begin(), candidates.end(), [](const TextureEntry* a, const TextureEntry* b)
+                    {
+                        return a->LastUsedFrame < b->LastUsedFrame;
+                    });
+
+                for (TextureEntry* entry : candidates)
+                {
+                    if (Stats.Bytes <= MemoryBudget)
+                        break;
+
+                    Unload(*entry);
+                    entry->State = TextureEntry::States::Evicted;
+                    Stats.Evictions++;
+                }
+            }
 
-            TextureCache.clear();
+            Frame++;
+        }
+
+        size_t GetTextureMemory(const std::string& name)
+        {
+            auto itr = TextureCache.find(name);
+            if (itr == TextureCache.end())
+                return 0;
+
+            return itr->second->Bytes;
+        }
+
+        const TextureStats& GetStats()
+        {
+            return Stats;
         }
     }
 
@@ -47,46 +361,252 @@ namespace RLGameGUI
         struct FontRecord
         {
             std::string FontName;
-            std::unordered_map<float, rltFont> Fonts;
+            rltFontFace* Face = nullptr;
+            bool FaceRead = false;
+            std::unordered_map<float, std::shared_ptr<rltFont>> Fonts;
+            std::shared_ptr<rltFont> SDFFont;
         };
 
         std::unordered_map<std::string, FontRecord> FontCache;
 
-        rltFont LoadFont(const std::string name, float size)
+        FontStats Stats;
+
+        std::string CacheDir;
+
+        bool UseSDF = false;
+        float SDFBaseSize = 48;
+
+        size_t GlyphCacheBudget = 0;
+
+        bool SingleChannel = false;
+
+        bool SharePages = false;
+        rltAtlasPages AtlasPages;
+
+        void SetCacheDir(const std::string& folderPath)
+        {
+            CacheDir = folderPath;
+        }
+
+        void SetSDFFonts(bool enabled, float baseSize)
         {
-            std::string filePath = TextureManager::ResourceDir + "/" + name;
+            UseSDF = enabled;
+            SDFBaseSize = baseSize;
+        }
 
-            return rltLoadFontTTF(filePath, size);
+        void SetSingleChannelFonts(bool enabled)
+        {
+            SingleChannel = enabled;
         }
 
-        rltFont GetFont(const std::string& name, float size)
+        void SetGlyphCacheBudget(size_t bytesPerFont)
         {
-            if (name.empty())
-                return rltGetDefaultFont();
+            GlyphCacheBudget = bytesPerFont;
+        }
+
+        void SetSharedAtlasPages(bool enabled, int pageSize)
+        {
+            SharePages = enabled;
+
+            // pages already made keep their size, only new ones use this
+            AtlasPages.PageSize = pageSize;
+        }
+
+        unsigned int GetStandardGlyphSetHash()
+        {
+            static unsigned int hash = 0;
+            if (hash == 0)
+            {
+                rltGlyphSet glyphSet;
+                rltGetStandardGlyphSet(glyphSet);
+                hash = rltHashGlyphSet(glyphSet);
+            }
+            return hash;
+        }
+
+        rltFont LoadFontSize(FontRecord& record, float size, bool sdf, const rltGlyphSet* glyphSet)
+        {
+            rltFontLoadOptions options;
+            options.SDF = sdf;
+            options.SingleChannel = SingleChannel;
+
+            if (CacheDir.empty())
+                return rltLoadFontFromFace(record.Face, size, glyphSet, nullptr, &options);
+
+            rltFontCacheKey key;
+            key.FileHash = rltGetFontFaceHash(record.Face);
+            key.Size = size;
+            key.GlyphSetHash = glyphSet ? rltHashGlyphSet(*glyphSet) : GetStandardGlyphSetHash();
+            key.RasterScale = rltGetRasterScale();
+            key.SDF = sdf;
+            key.SingleChannel = SingleChannel;
+            key.PowerOfTwoAtlas = options.PowerOfTwoAtlas;
+            key.MaxAtlasSize = options.MaxAtlasSize;
+            key.DefaultSpacing = size / 10.0f;
+
+            std::string cachePath = CacheDir + "/" + std::to_string(key.FileHash) + "_" + std::to_string(int(size * 100)) + "_" + std::to_string(key.GlyphSetHash) + "_" + std::to_string(int(key.RasterScale * 100)) + (sdf ? "_sdf" : "") + (SingleChannel ? "_r8" : "") + ".rltfont";
+
+            rltFont font;
+            if (rltLoadFontCache(&font, key, cachePath))
+            {
+                Stats.CacheHits++;
+                return font;
+            }
+
+            Stats.CacheMisses++;
+            font = rltLoadFontFromFace(record.Face, size, glyphSet, nullptr, &options);
+            rltSaveFontCache(&font, key, cachePath);
+            return font;
+        }
+
+        rltFont LoadFont(FontRecord& record, float size, bool sdf, const rltGlyphSet* glyphSet = nullptr)
+        {
+            double startTime = GetTime();
 
+            // every size comes from the same parsed face, so the file is only read once
+            if (!record.FaceRead)
+            {
+                std::string filePath = TextureManager::ResourceDir + "/" + record.FontName;
+
+                record.Face = rltLoadFontFace(filePath);
+                record.FaceRead = true;
+                Stats.FileReads++;
+            }
+
+            rltFont font;
+            if (record.Face)
+            {
+                font = LoadFontSize(record, size, sdf, glyphSet);
+                Stats.SizesLoaded++;
+
+                // after the disk cache, which only holds the preloaded glyphs
+                if (GlyphCacheBudget > 0)
+                    rltEnableGlyphCache(&font, record.Face, GlyphCacheBudget);
+
+                // after the glyph cache, which grows the atlas
+                if (SharePages)
+                {
+                    rltAddFontToAtlasPages(&font, AtlasPages);
+                    Stats.AtlasPages = AtlasPages.Pages.size();
+                }
+            }
+
+            Stats.LoadSeconds += GetTime() - startTime;
+            return font;
+        }
+
+        const FontStats& GetStats()
+        {
+            return Stats;
+        }
+
+        FontRecord& GetRecord(const std::string& name)
+        {
             auto fontItr = FontCache.find(name);
             if (fontItr == FontCache.end())
                 fontItr = FontCache.insert_or_assign(name, FontRecord{ name }).first;
 
-            auto& fonts = fontItr->second.Fonts;
+            return fontItr->second;
+        }
+
+        FontHandle GetFont(const std::string& name, float size)
+        {
+            // the default font is static, so the handle does not own it
+            if (name.empty())
+                return FontHandle(FontHandle(), &rltGetDefaultFont());
+
+            FontRecord& record = GetRecord(name);
+
+            // drawing scales by size over the base size, so the one SDF atlas serves them all
+            if (UseSDF)
+            {
+                if (!record.SDFFont)
+                    record.SDFFont = std::make_shared<rltFont>(LoadFont(record, SDFBaseSize, true));
+
+                return record.SDFFont;
+            }
+
+            auto& fonts = record.Fonts;
 
             auto sizeItr = fonts.find(size);
             if (sizeItr == fonts.end())
-                sizeItr = fonts.insert_or_assign(size, LoadFont(name, size)).first;
+                sizeItr = fonts.insert_or_assign(size, std::make_shared<rltFont>(LoadFont(record, size, false))).first;
 
             return sizeItr->second;
         }
 
+        void CollectGlyphs(const GUIElement* root, GlyphSets& glyphSets)
+        {
+            if (!root)
+                return;
+
+            root->CollectText([&glyphSets](const std::string& fontName, float fontSize, const std::string& text)
+                {
+                    rltAddGlyphSetFromString(text, glyphSets[std::make_pair(fontName, fontSize)]);
+                });
+
+            for (auto& child : root->Children)
+                CollectGlyphs(child.get(), glyphSets);
+        }
+
+        void AddStringsToGlyphSets(const std::vector<std::string>& strings, GlyphSets& glyphSets)
+        {
+            for (auto& [font, glyphSet] : glyphSets)
+            {
+                for (auto& text : strings)
+                    rltAddGlyphSetFromString(text, glyphSet);
+            }
+        }
+
+        void PreloadGlyphs(const GlyphSets& glyphSets)
+        {
+            // SDF fonts share one atlas across sizes, so it needs every size's glyphs
+            std::map<std::string, rltGlyphSet> sdfSets;
+
+            for (auto& [font, glyphSet] : glyphSets)
+            {
+                // the default font is built in
+                if (font.first.empty() || glyphSet.empty())
+                    continue;
+
+                if (UseSDF)
+                {
+                    sdfSets[font.first].insert(glyphSet.begin(), glyphSet.end());
+                    continue;
+                }
+
+                FontRecord& record = GetRecord(font.first);
+                if (record.Fonts.find(font.second) == record.Fonts.end())
+                    record.Fonts.insert_or_assign(font.second, std::make_shared<rltFont>(LoadFont(record, font.second, false, &glyphSet)));
+            }
+
+            for (auto& [name, glyphSet] : sdfSets)
+            {
+                FontRecord& record = GetRecord(name);
+                if (!record.SDFFont)
+                    record.SDFFont = std::make_shared<rltFont>(LoadFont(record, SDFBaseSize, true, &glyphSet));
+            }
+        }
+
         void UnloadAll()
         {
             for (auto& [key, fontGroup] : FontCache)
             {
                 for (auto& [size, font] : fontGroup.Fonts)
                 {
-                    rltUnloadFont(&font);
+                    rltUnloadFont(font.get());
                 }
+                if (fontGroup.SDFFont)
+                    rltUnloadFont(fontGroup.SDFFont.get());
+
+                rltUnloadFontFace(fontGroup.Face);
             }
             FontCache.clear();
+
+            rltUnloadAtlasPages(AtlasPages);
+            Stats.AtlasPages = 0;
+
+            rltUnloadFontShaders();
         }
     }
 }
\ No newline at end of file
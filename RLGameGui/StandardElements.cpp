@@ -30,9 +30,13 @@
 #include "raylib.h"
 #include "raymath.h"
 #include "GUITextureManager.h"
+#include "GUIDrawList.h"
 
 #include "rlText.h"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace rapidjson;
 
 namespace RLGameGUI
@@ -41,27 +45,109 @@ namespace RLGameGUI
     {
         GUIPanel::Register();
         GUILabel::Register();
+        GUINumberLabel::Register();
         GUIImage::Register();
         GUICheckBox::Register();
         GUIButton::Register();
     }
 
-    Texture2D TextureRecord::GetTexture()
+    Texture2D TextureRecord::GetTexture(GUIElement* owner)
     {
-        if (Texture.id != 0)
-            return Texture;
+        // the handle keeps working after an eviction, the texture just loads again
+        if (!Texture || Texture->Name != Name)
+            Texture = TextureManager::AcquireTexture(Name);
+
+        Texture2D texture = TextureManager::GetTexture(Texture);
+
+        if (Pending && texture.id != 0 && owner != nullptr)
+            owner->InvalidateLayout();
+        Pending = Texture->State == TextureManager::TextureEntry::States::Loading;
 
-        Texture = TextureManager::GetTexture(Name);
-        return Texture;
+        return texture;
     }
 
-    rltFont FontRecord::GetFont()
+    const rltFont* FontRecord::GetFont()
     {
-        if (!CachedFont.Ranges.empty())
-            return CachedFont;
+        // FontManager::UnloadAll empties the font in place, so an empty one may have been reloaded since
+        if (!Font || Font->Ranges.empty() || FontSize != Size || FontName != Name)
+        {
+            Font = FontManager::GetFont(Name, Size);
+            FontName = Name;
+            FontSize = Size;
+        }
+
+        if (Font->Ranges.empty())
+            return &rltGetDefaultFont();
 
-        CachedFont = FontManager::GetFont(Name, Size);
-        return CachedFont;
+        return Font.get();
+    }
+
+    void TextLayoutRecord::Update(const std::string& text, float& size, const rltFont* font)
+    {
+        if (size < MinimumSize)
+            size = MinimumSize;
+
+        if (IsCurrent(font, size, LayoutModes::Plain))
+            return;
+
+        rltBuildTextLayout(Layout, text, size, font);
+        Mode = LayoutModes::Plain;
+        Dirty = false;
+        Font = font;
+        Size = size;
+    }
+
+    void TextLayoutRecord::UpdateWrapped(const std::string& text, float& size, const rltFont* font, float width, rltAllignment allignment)
+    {
+        if (size < MinimumSize)
+            size = MinimumSize;
+
+        bool linesCurrent = IsCurrent(font, size, LayoutModes::Wrapped);
+        if (linesCurrent && width == Lines.Width && allignment == Allignment)
+            return;
+
+        // words are only measured when the text or font changes, a resize just moves the breaks
+        if (linesCurrent)
+            rltReflowWrappedText(Lines, width);
+        else
+            rltBuildWrappedText(Lines, text, size, width, font);
+
+        rltBuildWrappedTextLayout(Layout, text, Lines, size, allignment, font);
+        Dirty = false;
+        Font = font;
+        Size = size;
+        Mode = LayoutModes::Wrapped;
+        Allignment = allignment;
+    }
+
+    void TextLayoutRecord::UpdateTruncated(const std::string& text, float& size, const rltFont* font, float width)
+    {
+        if (size < MinimumSize)
+            size = MinimumSize;
+
+        bool advancesCurrent = IsCurrent(font, size, LayoutModes::Truncated);
+        if (advancesCurrent && width == TruncateWidth)
+            return;
+
+        if (!advancesCurrent)
+        {
+            rltBuildTextAdvances(Advances, text, size, font);
+            TruncatedText.clear();
+        }
+
+        std::string truncated;
+        bool cut = rltTruncateText(truncated, text, Advances, width, size, font);
+
+        // the layout only changes when the cut moves
+        if (!advancesCurrent || truncated != TruncatedText)
+            rltBuildTextLayout(Layout, cut ? truncated : text, size, font);
+
+        TruncatedText = std::move(truncated);
+        TruncateWidth = width;
+        Dirty = false;
+        Font = font;
+        Size = size;
+        Mode = LayoutModes::Truncated;
     }
 
     bool GUITexture::Read(const rapidjson::Value& object)
@@ -122,18 +208,18 @@ namespace RLGameGUI
 
         if (fill.a != 0)
         {
-            DrawRectangleRec(rect, fill);
+            Renderer::DrawRectangle(rect, fill);
         }
         if (outline.a != 0 && OutlineThickness > 0)
         {
 			rect.height += 1;
-			DrawRectangleLinesEx(rect, float(OutlineThickness), outline);
+			Renderer::DrawRectangleLines(rect, float(OutlineThickness), outline);
         }
     }
 
     void DrawTextureTiled(const Texture2D& fill, const Rectangle& source, const Rectangle& rect, Color& tint)
     {
-        BeginScissorMode(int(rect.x), int(rect.y), int(rect.width), int(rect.height));
+        Renderer::BeginClip(rect);
 
         int hCount = int((source.width / rect.width) + 0.5f);
         int vCount = int((source.height / rect.height) + 0.5f);
@@ -142,11 +228,11 @@ namespace RLGameGUI
         {
             for (int h = 0; h < hCount; h++)
             {
-                DrawTexturePro(fill, source, Rectangle{ h * source.width,v * source.height, source.width,source.height }, Vector2Zeros, 0, tint);
+                Renderer::DrawTexture(fill, source, Rectangle{ h * source.width,v * source.height, source.width,source.height }, tint);
             }
         }
 
-        EndScissorMode();
+        Renderer::EndClip();
     }
 
     void GUIPanel::Draw(GUITexture& fill)
@@ -169,7 +255,7 @@ namespace RLGameGUI
         }
         else if (fill.Fillmode == PanelFillModes::Fill)
         {
-            DrawTexturePro(texture, fill.SourceRect, rect, Vector2Zeros, 0, fill.Tint);
+            Renderer::DrawTexture(texture, fill.SourceRect, rect, fill.Tint);
         }
         else if (fill.Fillmode == PanelFillModes::NPatch)
         {
@@ -192,7 +278,7 @@ namespace RLGameGUI
             } 
             NPatchData.source = fill.SourceRect;
 
-            DrawTextureNPatch(texture, NPatchData, rect, Vector2Zeros, 0, fill.Tint);
+            Renderer::DrawTextureNPatch(texture, NPatchData, rect, fill.Tint);
         }
     }
 
@@ -239,9 +325,9 @@ namespace RLGameGUI
     void GUIImage::OnRender()
     {
 		if (!Background.Valid())
-			DrawRectangleRec(GetScreenRect(), Tint);
+			Renderer::DrawRectangle(GetScreenRect(), Tint);
 		else
-			DrawTexturePro(Background.GetTexture(), RealSourceRect, RealDestRect, Vector2Zeros, 0, Tint);
+			Renderer::DrawTexture(Background.GetTexture(this), RealSourceRect, RealDestRect, Tint);
     }
 
     void GUIImage::OnUpdate()
@@ -251,6 +337,7 @@ namespace RLGameGUI
 
     void GUIImage::OnPreResize()
     {
+        // no owner here, a texture that arrives now is used by the resize already running
         if (RelativeBounds.Size.IsZero())
         {
             RelativeBounds.Size = RelativePoint(Background.GetTexture().width, Background.GetTexture().height);
@@ -312,18 +399,8 @@ namespace RLGameGUI
         return true;
     }
 
-    static Rectangle ResizeTextBox(float& textSize, const std::string& text, rltFont& textFont, Rectangle& screenRect, RLGameGUI::AlignmentTypes hAlign, RLGameGUI::AlignmentTypes vAlign)
+    static Rectangle ResizeTextBox(const Vector2& size, const rltFont* fontToUse, Rectangle& screenRect, RLGameGUI::AlignmentTypes hAlign, RLGameGUI::AlignmentTypes vAlign)
     {
-        float defaultFontSize = 10;   // Default Font chars height in pixel
-        if (textSize < defaultFontSize)
-            textSize = defaultFontSize;
-
-        const rltFont *fontToUse = &textFont;
-        if (textFont.Ranges.empty())
-            fontToUse = &rltGetDefaultFont();
-
-        Vector2 size = rltMeasureText(text, float(textSize), fontToUse);
-
         Rectangle textRect = { 0,0,0,0 };
 
         textRect.width = size.x + fontToUse->DefaultSpacing * 2;
@@ -363,26 +440,62 @@ namespace RLGameGUI
 
     void GUILabel::OnResize()
     {
-        TextRect = ResizeTextBox(TextFont.Size, Text, TextFont.GetFont(), ScreenRect, HorizontalAlignment, VerticalAlignment);
+        const rltFont* font = TextFont.GetFont();
+
+        if (WordWrap)
+        {
+            rltAllignment allignment = rltAllignment::Left;
+            if (HorizontalAlignment == AlignmentTypes::Center)
+                allignment = rltAllignment::Center;
+            else if (HorizontalAlignment == AlignmentTypes::Maximum)
+                allignment = rltAllignment::Right;
+
+            // leave room for the spacing ResizeTextBox puts around the text
+            TextLayout.UpdateWrapped(Text, TextFont.Size, font, ScreenRect.width - font->DefaultSpacing * 2, allignment);
+        }
+        else if (Truncate)
+        {
+            TextLayout.UpdateTruncated(Text, TextFont.Size, font, ScreenRect.width - font->DefaultSpacing * 2);
+        }
+        else
+        {
+            TextLayout.Update(Text, TextFont.Size, font);
+        }
+
+        TextRect = ResizeTextBox(TextLayout.Layout.Size, font, ScreenRect, HorizontalAlignment, VerticalAlignment);
     }
 
-    void DrawTextRect(const rltFont& fontToUse, const std::string& text, const Rectangle& rect, float size, Color tint, bool clip)
+    void DrawTextRect(const rltTextLayout& layout, const Rectangle& rect, Color tint, bool clip)
     {
         if (clip)
-            BeginScissorMode(int(rect.x), int(rect.y), int(rect.width), int(rect.height));
+            Renderer::BeginClip(rect);
         
-        Vector2 bounds = rltMeasureText(text, size, &fontToUse);
         Vector2 center = Vector2{ rect.x + (rect.width / 2.0f), rect.y + (rect.height / 2.0f) };
-        Vector2 pos = center - (bounds * 0.5f);
-        rltDrawText(text, size, pos, tint, &fontToUse);
+        Vector2 pos = center - (layout.Size * 0.5f);
+        rltDrawTextLayout(layout, pos, tint);
 
         if (clip)
-            EndScissorMode();
+            Renderer::EndClip();
+    }
+
+    TextLayoutRecord::LayoutModes GUILabel::GetLayoutMode() const
+    {
+        if (WordWrap)
+            return TextLayoutRecord::LayoutModes::Wrapped;
+
+        if (Truncate)
+            return TextLayoutRecord::LayoutModes::Truncated;
+
+        return TextLayoutRecord::LayoutModes::Plain;
     }
 
     void GUILabel::OnRender()
     {
-        DrawTextRect(TextFont.GetFont(), Text.c_str(), TextRect, TextFont.Size, Tint, ClipToRectangle);
+        // the font and layout mode can be changed without a resize
+        if (!TextLayout.IsCurrent(TextFont.GetFont(), TextFont.Size, GetLayoutMode()))
+            OnResize();
+
+        DrawTextRect(TextLayout.Layout, TextRect, Tint, ClipToRectangle);
     }
 
     bool GUILabel::Read(const Value& object, Document& document)
@@ -397,6 +510,8 @@ namespace RLGameGUI
         GUIScreenReader::ReadMember(object, "text", Text);
 
         GUIScreenReader::ReadMember(object, "clip_to_rect", ClipToRectangle);
+        GUIScreenReader::ReadMember(object, "word_wrap", WordWrap);
+        GUIScreenReader::ReadMember(object, "truncate", Truncate);
 
         GUIScreenReader::ReadAllignmentType(object, "horizontal_allignment", HorizontalAlignment);
         GUIScreenReader::ReadAllignmentType(object, "vertical_allignment", VerticalAlignment);
@@ -418,6 +533,232 @@ namespace RLGameGUI
         object.AddMember("text", Value(Text.c_str(), alloc), alloc);
 
         object.AddMember("clip_to_rect", ClipToRectangle, alloc);
+        object.AddMember("word_wrap", WordWrap, alloc);
+        object.AddMember("truncate", Truncate, alloc);
+
+        GUIScreenWriter::WriteAllignmentType(object, "horizontal_allignment", HorizontalAlignment, document);
+        GUIScreenWriter::WriteAllignmentType(object, "vertical_allignment", VerticalAlignment, document);
+
+        return true;
+    }
+
+    void GUILabel::CollectText(const TextFunction& collect) const
+    {
+        collect(TextFont.Name, std::max(TextFont.Size, TextLayoutRecord::MinimumSize), Text);
+    }
+
+    // everything to_chars writes for finite and infinite values, hex floats add the digits b to d and the p exponent (to_chars writes no 0x)
+    static constexpr char NumberCharacters[] = "0123456789+-.einfabcdp";
+
+    GUINumberLabel::GUINumberLabel()
+    {
+        // the quads are rewritten in place, so they never need to grow past the longest number
+        Layout.Quads.reserve(sizeof(Buffer));
+        Format();
+    }
+
+    GUINumberLabel::GUINumberLabel(int value, const std::string& font, float size)
+        : GUINumberLabel()
+    {
+        TextFont.Name = font;
+        TextFont.Size = size;
+        SetValue(value);
+    }
+
+    GUINumberLabel::GUINumberLabel(float value, int precision, const std::string& font, float size)
+        : GUINumberLabel()
+    {
+        TextFont.Name = font;
+        TextFont.Size = size;
+        Precision = precision;
+        SetValue(value);
+    }
+
+    void GUINumberLabel::SetValue(int value)
+    {
+        if (!UseFloat && value == IntValue && Length > 0)
+            return;
+
+        UseFloat = false;
+        IntValue = value;
+        Format();
+    }
+
+    void GUINumberLabel::SetValue(float value)
+    {
+        if (UseFloat && value == FloatValue && Length > 0)
+            return;
+
+        UseFloat = true;
+        FloatValue = value;
+        Format();
+    }
+
+    void GUINumberLabel::Format()
+    {
+        char* end = Buffer + sizeof(Buffer);
+
+        std::to_chars_result result;
+        if (UseFloat)
+        {
+            if (Precision < 0)
+                result = std::to_chars(Buffer, end, FloatValue, FloatFormat);
+            else
+                result = std::to_chars(Buffer, end, FloatValue, FloatFormat, Precision);
+        }
+        else
+        {
+            result = std::to_chars(Buffer, end, IntValue);
+        }
+
+        Length = result.ec == std::errc() ? size_t(result.ptr - Buffer) : 0;
+
+        if (!UseFloat && Length > 0)
+        {
+            size_t signLength = Buffer[0] == '-' ? 1 : 0;
+            size_t digits = Length - signLength;
+
+            if (digits < size_t(MinimumDigits) && size_t(MinimumDigits) + signLength <= sizeof(Buffer))
+            {
+                size_t padding = size_t(MinimumDigits) - digits;
+                memmove(Buffer + signLength + padding, Buffer + signLength, digits);
+                memset(Buffer + signLength, '0', padding);
+                Length += padding;
+            }
+        }
+
+        // before the first render the glyphs are not known yet
+        if (GlyphFont)
+            BuildQuads();
+    }
+
+    void GUINumberLabel::BuildGlyphs(const rltFont* font)
+    {
+        for (auto& glyph : Glyphs)
+            glyph.Valid = false;
+
+        for (const char* character = NumberCharacters; *character != '\0'; character++)
+        {
+            NumberGlyph& glyph = Glyphs[int(*character)];
+            glyph.Valid = rltGetGlyphQuad(glyph.Quad, glyph.Advance, *character, TextFont.Size, font);
+        }
+
+        GlyphFont = font;
+        GlyphSize = TextFont.Size;
+
+        Layout.Texture = font->Texture;
+        Layout.SDF = font->SDF;
+        Layout.GlyphCacheGeneration = rltGetGlyphCacheGeneration(font);
+        Layout.Size.y = font->DefaultNewlineOffset * (TextFont.Size / font->BaseSize);
+    }
+
+    void GUINumberLabel::BuildQuads()
+    {
+        Layout.Quads.clear();
+
+        float x = 0;
+        for (size_t i = 0; i < Length; i++)
+        {
+            const NumberGlyph& glyph = Glyphs[int(Buffer[i]) & 127];
+            if (!glyph.Valid)
+                continue;
+
+            Layout.Quads.push_back(glyph.Quad);
+            Layout.Quads.back().Dest.x += x;
+            x += glyph.Advance;
+        }
+
+        Layout.Size.x = x;
+
+        TextRect = ResizeTextBox(Layout.Size, GlyphFont, ScreenRect, HorizontalAlignment, VerticalAlignment);
+    }
+
+    void GUINumberLabel::OnResize()
+    {
+        if (TextFont.Size < TextLayoutRecord::MinimumSize)
+            TextFont.Size = TextLayoutRecord::MinimumSize;
+
+        const rltFont* font = TextFont.GetFont();
+        if (font != GlyphFont || TextFont.Size != GlyphSize || Layout.GlyphCacheGeneration != rltGetGlyphCacheGeneration(font))
+            BuildGlyphs(font);
+
+        BuildQuads();
+    }
+
+    void GUINumberLabel::OnRender()
+    {
+        // the font can be swapped without a resize
+        const rltFont* font = TextFont.GetFont();
+        if (font != GlyphFont || TextFont.Size != GlyphSize || Layout.GlyphCacheGeneration != rltGetGlyphCacheGeneration(font))
+            OnResize();
+
+        DrawTextRect(Layout, TextRect, Tint, false);
+    }
+
+    bool GUINumberLabel::Read(const Value& object, Document& document)
+    {
+        GUIElement::Read(object, document);
+
+        GUIScreenReader::ReadColor(object, "tint", Tint);
+
+        GUIScreenReader::ReadMember(object, "text_font", TextFont.Name);
+        GUIScreenReader::ReadMember(object, "text_size", TextFont.Size);
+
+        GUIScreenReader::ReadMember(object, "float_value", UseFloat);
+        if (UseFloat)
+            GUIScreenReader::ReadMember(object, "value", FloatValue);
+        else
+            GUIScreenReader::ReadMember(object, "value", IntValue);
+
+        std::string format;
+        GUIScreenReader::ReadMember(object, "float_format", format);
+        if (format == "scientific")
+            FloatFormat = std::chars_format::scientific;
+        else if (format == "general")
+            FloatFormat = std::chars_format::general;
+        else if (format == "hex")
+            FloatFormat = std::chars_format::hex;
+        else
+            FloatFormat = std::chars_format::fixed;
+
+        GUIScreenReader::ReadMember(object, "precision", Precision);
+        GUIScreenReader::ReadMember(object, "minimum_digits", MinimumDigits);
+
+        GUIScreenReader::ReadAllignmentType(object, "horizontal_allignment", HorizontalAlignment);
+        GUIScreenReader::ReadAllignmentType(object, "vertical_allignment", VerticalAlignment);
+
+        Format();
+        return true;
+    }
+
+    bool GUINumberLabel::Write(Value& object, Document& document)
+    {
+        GUIElement::Write(object, document);
+        auto& alloc = document.GetAllocator();
+
+        GUIScreenWriter::WriteColor(object, "tint", Tint, document);
+        if (!TextFont.Name.empty())
+            object.AddMember("text_font", Value(TextFont.Name.c_str(), alloc), alloc);
+
+        object.AddMember("text_size", TextFont.Size, alloc);
+
+        object.AddMember("float_value", UseFloat, alloc);
+        if (UseFloat)
+            object.AddMember("value", FloatValue, alloc);
+        else
+            object.AddMember("value", IntValue, alloc);
+
+        if (FloatFormat == std::chars_format::scientific)
+            object.AddMember("float_format", "scientific", alloc);
+        else if (FloatFormat == std::chars_format::general)
+            object.AddMember("float_format", "general", alloc);
+        else if (FloatFormat == std::chars_format::hex)
+            object.AddMember("float_format", "hex", alloc);
+        else
+            object.AddMember("float_format", "fixed", alloc);
+
+        object.AddMember("precision", Precision, alloc);
+        object.AddMember("minimum_digits", MinimumDigits, alloc);
 
         GUIScreenWriter::WriteAllignmentType(object, "horizontal_allignment", HorizontalAlignment, document);
         GUIScreenWriter::WriteAllignmentType(object, "vertical_allignment", VerticalAlignment, document);
@@ -425,6 +766,11 @@ namespace RLGameGUI
         return true;
     }
 
+    void GUINumberLabel::CollectText(const TextFunction& collect) const
+    {
+        collect(TextFont.Name, std::max(TextFont.Size, TextLayoutRecord::MinimumSize), NumberCharacters);
+    }
+
     void GUIButton::SetButtonFrames(int framesX, int framesY, int backgroundX, int backgroundY, int hoverX, int hoverY, int pressX, int pressY, int disableX, int disableY )
     {
         float xGrid = (float)Background.Texture.GetTexture().width / (float)framesX;
@@ -465,7 +811,8 @@ namespace RLGameGUI
 
     void GUIButton::OnResize()
     {
-        TextRect = ResizeTextBox(TextFont.Size, Text, TextFont.GetFont(), ScreenRect, AlignmentTypes::Center, AlignmentTypes::Center);
+        TextLayout.Update(Text, TextFont.Size, TextFont.GetFont());
+        TextRect = ResizeTextBox(TextLayout.Layout.Size, TextFont.GetFont(), ScreenRect, AlignmentTypes::Center, AlignmentTypes::Center);
     }
 
     void GUIButton::OnRender()
@@ -507,11 +854,15 @@ namespace RLGameGUI
 
         if (!Text.empty())
         {
+            // the font can be swapped without a resize
+            if (!TextLayout.IsCurrent(TextFont.GetFont(), TextFont.Size))
+                OnResize();
+
             Rectangle rect = TextRect;
             rect.x += tx->Offset.x;
             rect.y += tx->Offset.y;
 
-            DrawTextRect(TextFont.GetFont(), Text, rect, TextFont.Size, labelColor, true);
+            DrawTextRect(TextLayout.Layout, rect, labelColor, true);
         }
     }
 
@@ -571,6 +922,11 @@ namespace RLGameGUI
         return true;
     }
 
+    void GUIButton::CollectText(const TextFunction& collect) const
+    {
+        collect(TextFont.Name, std::max(TextFont.Size, TextLayoutRecord::MinimumSize), Text);
+    }
+
     std::vector<std::string>::const_iterator GUIComboBox::Begin()
     {
         return Items.cbegin();
@@ -583,11 +939,13 @@ namespace RLGameGUI
 
     std::vector<std::string>::const_iterator GUIComboBox::Erase(const std::vector<std::string>::const_iterator itr)
     {
+        RequestUpdate();
         return Items.erase(itr);
     }
 
     void GUIComboBox::Add(const std::string& item)
     {
+        RequestUpdate();
         Items.emplace_back(item);
         if (SelectedItem < 0)
         {
@@ -598,6 +956,7 @@ namespace RLGameGUI
 
     void GUIComboBox::Clear()
     {
+        RequestUpdate();
         Items.clear();
         SelectedItem = -1;
         TextLabel->SetText("");
@@ -614,6 +973,7 @@ namespace RLGameGUI
             SelectedItem = -1;
 
         SelectedItem = item;
+        RequestUpdate();
 
         PostEvent(this, GUIElementEvent::Changed, &SelectedItem);
     }
@@ -662,6 +1022,7 @@ namespace RLGameGUI
         TextLabel->RelativeBounds = RelativeRect(RelativeValue(0.0f, true), RelativeValue(0.0f, false), RelativeValue(1.0f, true), RelativeValue(1.0f, false));
         TextLabel->HorizontalAlignment = AlignmentTypes::Center;
         TextLabel->VerticalAlignment = AlignmentTypes::Center;
+        TextLabel->Truncate = true;
         AddChild(TextLabel);
     }
 
@@ -670,8 +1031,8 @@ namespace RLGameGUI
         WantDecrement = false;
         WantIncrement = false;
 
-        DecrementButton->Disabled = SelectedItem <= 0;
-        IncrementButton->Disabled = SelectedItem < 0 || SelectedItem == int(Items.size()) - 1;
+        DecrementButton->SetDisabled(SelectedItem <= 0);
+        IncrementButton->SetDisabled(SelectedItem < 0 || SelectedItem == int(Items.size()) - 1);
     }
 
     void GUIComboBox::OnPostChildUpdate()
@@ -769,6 +1130,12 @@ namespace RLGameGUI
         return true;
     }
 
+    void GUIComboBox::CollectText(const TextFunction& collect) const
+    {
+        for (auto& item : Items)
+            collect(TextLabel->TextFont.Name, std::max(TextLabel->TextFont.Size, TextLayoutRecord::MinimumSize), item);
+    }
+
     bool GUICheckBox::SetChecked(bool check)
     {
         if (check == Checked)
@@ -0,0 +1,128 @@
+/**********************************************************************************************
+*
+*   RLGameGUi * A game gui for raylib
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "raylib.h"
+
+namespace RLGameGUI
+{
+	// Records textured quads for a frame and submits them grouped by texture and clip, keeping draw order where quads overlap
+	class GUIDrawList
+	{
+	public:
+		struct DrawStats
+		{
+			size_t Commands = 0;
+			size_t Culled = 0;
+			// state changes that force rlgl to flush, each costs at least one GPU draw call and rlgl can split one further when its vertex buffer fills
+			size_t Batches = 0;
+			size_t TextureSwitches = 0;
+		};
+
+		// how many earlier batches a quad may skip over to join one with the same texture
+		int MaxBatchSearch = 16;
+
+		void Clear();
+
+		void SetLayer(int layer);
+		inline int GetLayer() const { return Layer; }
+
+		void PushClip(const Rectangle& rect);
+		void PopClip();
+
+		// shader is for quads that can't use the default one, like text from SDF or single channel font atlases
+		void AddQuad(const Texture2D& texture, const Rectangle& source, const Rectangle& dest, Color tint, const Shader* shader = nullptr);
+		void AddRectangle(const Rectangle& rect, Color color);
+		void AddRectangleLines(const Rectangle& rect, float thickness, Color color);
+		void AddNPatch(const Texture2D& texture, const NPatchInfo& info, const Rectangle& dest, Color tint);
+
+		void Submit();
+
+		inline const DrawStats& GetStats() const { return Stats; }
+
+	protected:
+		struct Command
+		{
+			Texture2D Texture = { 0 };
+			Rectangle Source = { 0,0,0,0 };
+			Rectangle Dest = { 0,0,0,0 };
+			Color Tint = { 0,0,0,0 };
+			bool Solid = false;
+			const Shader* QuadShader = nullptr;
+			int Batch = 0;
+		};
+
+		struct Batch
+		{
+			unsigned int TextureID = 0;
+			bool Solid = false;
+			const Shader* QuadShader = nullptr;
+			int Clip = 0;
+			Rectangle Bounds = { 0,0,0,0 };
+			int Count = 0;
+			int Start = 0;
+		};
+
+		int Layer = 0;
+		size_t LayerFirstBatch = 0;
+
+		std::vector<Rectangle> Clips;
+		std::vector<int> ClipStack;
+
+		std::vector<Command> Commands;
+		std::vector<Batch> Batches;
+		std::vector<int> CommandOrder;
+
+		DrawStats Stats;
+
+		void Add(const Command& command);
+		int FindBatch(const Command& command, const Rectangle& bounds) const;
+	};
+
+	// Draw functions used by elements, recorded into the bound draw list or drawn immediately when none is bound
+	namespace Renderer
+	{
+		void Begin(GUIDrawList* list);
+		void End();
+
+		GUIDrawList* GetDrawList();
+
+		void DrawTexture(const Texture2D& texture, const Rectangle& source, const Rectangle& dest, Color tint);
+		void DrawRectangle(const Rectangle& rect, Color color);
+		void DrawRectangleLines(const Rectangle& rect, float thickness, Color color);
+		void DrawTextureNPatch(const Texture2D& texture, const NPatchInfo& info, const Rectangle& dest, Color tint);
+
+		void BeginClip(const Rectangle& rect);
+		void EndClip();
+	}
+}
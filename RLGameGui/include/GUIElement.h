@@ -32,7 +32,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
-
+#include <cstdint>
 
 #include "raylib.h"
 #include "rapidjson/document.h"
@@ -93,7 +93,8 @@ namespace RLGameGUI
         virtual bool Write(rapidjson::Value& object, rapidjson::Document& document);
 
 	protected:
-		bool Dirty = false;
+		// a freshly constructed value has never been resolved, so assigning one over an existing value reads as a change
+		bool Dirty = true;
 	};
 
 	class RelativePoint
@@ -182,7 +183,14 @@ namespace RLGameGUI
 
 		void Update(Vector2 mousePosition);
 		void Render();
-		void Resize();
+		size_t Resize();
+
+		// flags this element for the owning screen's next layout pass
+		void InvalidateLayout();
+		inline bool NeedsLayout() const { return LayoutDirty || ChildLayoutDirty; }
+
+		// keeps the owning screen from skipping its next update, elements that animate call this every frame they are animating
+		void RequestUpdate();
 
 		typedef std::shared_ptr<GUIElement> Ptr;
 		typedef std::function<void(GUIElement*)> Function;
@@ -191,16 +199,28 @@ namespace RLGameGUI
 		std::vector<GUIElement::Ptr> Children;
 
 		virtual GUIElement::Ptr AddChild(GUIElement::Ptr child);
+		virtual void RemoveChild(GUIElement::Ptr child);
 
+		// bounds assigned directly are only noticed by the next update walk, set them here to have them resolved before the next render
 		RelativeRect RelativeBounds;
+		void SetRelativeBounds(const RelativeRect& bounds);
 
+		// writing these directly does not wake a screen that skips idle updates, use the setters or call RequestUpdate()
 		bool Hidden = false;
 		bool Disabled = false;
 
+		void SetHidden(bool hidden);
+		void SetDisabled(bool disabled);
+
 		RelativePoint Padding;
 
 		Function ElementClicked = nullptr;
 
+		typedef std::function<void(const std::string& fontName, float fontSize, const std::string& text)> TextFunction;
+
+		// reports every string this element can draw and the font it draws it with, children report their own
+		virtual void CollectText(const TextFunction& /*collect*/) const {}
+
 		virtual bool Read(const rapidjson::Value& object, rapidjson::Document& document);
 		virtual bool Write(rapidjson::Value& object, rapidjson::Document& document);
 		
@@ -226,12 +246,22 @@ namespace RLGameGUI
         virtual const Rectangle& GetContentRect();
 
 	protected:
+		friend class GUIScreen;
 
 		bool Renders = true;
 		
 		bool Hovered = false;
 		bool Clicked = false;
 
+		bool LayoutDirty = false;
+		bool ChildLayoutDirty = false;
+
+		uint32_t PointerCandidateFrame = 0;
+
+		void UpdateTree(Vector2 mousePosition, uint32_t hitFrame);
+		void ResizeSelf();
+		void ProcessPointer(bool inside);
+
 		virtual void OnPreUpdate() {}
 		virtual void OnUpdate() {}
         virtual void OnPostChildUpdate() {}
@@ -249,6 +279,10 @@ namespace RLGameGUI
 		virtual void OnClickCancel() {}
 
 		virtual void PostEvent(GUIElement* element, GUIElementEvent eventType, void* data);
+		virtual void OnTreeChanged();
+		// called on the parent before a child and everything under it is detached
+		virtual void OnSubtreeRemoved(GUIElement* root);
+		virtual void OnUpdateRequested();
 
 		Rectangle ScreenRect = { 0,0,0,0 };
 		Rectangle ContentRect = { 0,0,0,0 };
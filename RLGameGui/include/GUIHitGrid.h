@@ -0,0 +1,83 @@
+/**********************************************************************************************
+*
+*   RLGameGUi * A game gui for raylib
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "raylib.h"
+
+namespace RLGameGUI
+{
+	class GUIElement;
+
+	// Uniform grid of element screen rects, used to find the few elements under the pointer
+	class GUIHitGrid
+	{
+	public:
+		float CellSize = 64;
+
+		void Reset(const Rectangle& bounds);
+		void Clear();
+
+		// re-buckets the element only when its rect changed
+		void Update(GUIElement* element, const Rectangle& rect);
+		void Remove(GUIElement* element);
+
+		// appends every indexed element that contains the point
+		void Query(Vector2 point, std::vector<GUIElement*>& results) const;
+
+		inline size_t Size() const { return Entries.size(); }
+
+	protected:
+		struct Entry
+		{
+			Rectangle Rect = { 0,0,0,0 };
+			int MinX = 0;
+			int MinY = 0;
+			int MaxX = -1;
+			int MaxY = -1;
+			bool Overflow = false;
+		};
+
+		Rectangle Bounds = { 0,0,0,0 };
+		int Columns = 0;
+		int Rows = 0;
+
+		std::vector<std::vector<GUIElement*>> Cells;
+		std::vector<GUIElement*> Overflow;
+		std::unordered_map<GUIElement*, Entry> Entries;
+
+		void Insert(GUIElement* element, Entry& entry);
+		void Unlink(GUIElement* element, Entry& entry);
+
+		static void EraseFrom(std::vector<GUIElement*>& list, GUIElement* element);
+	};
+}
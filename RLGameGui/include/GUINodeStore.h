@@ -0,0 +1,70 @@
+/**********************************************************************************************
+*
+*   RLGameGUi * A game gui for raylib
+*
+*   LICENSE: MIT
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in all
+*   copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*   SOFTWARE.
+*
+**********************************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "raylib.h"
+
+namespace RLGameGUI
+{
+	class GUIElement;
+
+	// Flattened pre-order copy of an element tree.
+	// The per frame data is kept in parallel arrays so the screen can walk the tree linearly,
+	// a node's subtree is always the range [node, SubtreeEnds[node]).
+	class GUINodeStore
+	{
+	public:
+		enum NodeFlags : uint8_t
+		{
+			InputBlocked = 1 << 0,
+		};
+
+		std::vector<GUIElement*> Elements;
+
+		std::vector<int> Parents;
+		std::vector<int> SubtreeEnds;
+
+		std::vector<Rectangle> ScreenRects;
+		std::vector<uint8_t> Flags;
+
+		void Build(GUIElement* root);
+		void Clear();
+
+		void SyncRects(int node);
+
+		inline int Size() const { return int(Elements.size()); }
+
+	protected:
+		int AddNode(GUIElement* element, int parent);
+	};
+}
@@ -36,6 +36,9 @@
 #include <map>
 
 #include "GUIElement.h"
+#include "GUINodeStore.h"
+#include "GUIHitGrid.h"
+#include "GUIDrawList.h"
 #include "RootElement.h"
 
 namespace RLGameGUI
@@ -72,10 +75,80 @@ namespace RLGameGUI
 
 		void RegisterEventHandler(const std::string& elmentId, GUIElementEvent eventType, EventHandler handler);
 
+		// walk a flattened copy of the element tree instead of recursing through the children
+		bool UseNodeStore = false;
+		inline const GUINodeStore& GetNodeStore() const { return NodeStore; }
+
+		// find the elements under the pointer from a grid of their screen rects instead of testing every element
+		bool UseHitGrid = false;
+		inline const GUIHitGrid& GetHitGrid() const { return HitGrid; }
+
+		// record element drawing into a draw list and submit it grouped by texture, elements must draw through Renderer
+		bool UseDrawList = false;
+		inline const GUIDrawList& GetDrawList() const { return DrawList; }
+
+		// skip the element walk on frames with no pointer change, no pending layout and no update requests
+		// Hidden and Disabled must be changed through SetHidden/SetDisabled (or followed by RequestUpdate) or hover and click state goes stale
+		bool SkipIdleUpdates = false;
+		inline size_t GetSkippedUpdateCount() const { return SkippedUpdates; }
+
+		struct FrameStats
+		{
+			size_t ResolvedNodes = 0;
+			size_t LayoutPasses = 0;
+			size_t PointerCandidates = 0;
+			bool UpdateSkipped = false;
+		};
+
+		// counters for the current frame, reset at the start of each Update
+		inline const FrameStats& GetFrameStats() const { return Stats; }
+
 	protected:
 		bool Active = false;
 
+		FrameStats Stats;
+
 		void DoResize();
+		void DoLayout();
+
+		GUINodeStore NodeStore;
+		bool NodeStoreDirty = true;
+		std::vector<std::pair<int, GUIElement*>> NodeWalkStack;
+
+		void BuildNodeStore();
+		size_t ResolveNodeLayout();
+		void UpdateNodes(Vector2 mousePosition, uint32_t hitFrame);
+		void RenderNodes();
+
+		std::vector<GUIElement*> LayoutRoots;
+
+		void CollectLayoutRoots(GUIElement* element);
+		size_t ResolveTreeLayout();
+
+		GUIDrawList DrawList;
+
+		GUIHitGrid HitGrid;
+		bool HitGridDirty = true;
+		uint32_t HitFrame = 0;
+		std::vector<GUIElement*> HitCandidates;
+
+		void RebuildHitGrid();
+		void IndexSubtree(GUIElement* element);
+		void UnindexSubtree(GUIElement* element);
+		uint32_t FindPointerCandidates(Vector2 mousePosition);
+
+		// added elements are indexed by the layout pass they trigger, removed ones are taken out of the grid one by one
+		void OnTreeChanged() override { NodeStoreDirty = true; UpdateRequested = true; }
+		void OnSubtreeRemoved(GUIElement* root) override;
+
+		bool UpdateRequested = true;
+		size_t SkippedUpdates = 0;
+		Vector2 LastMousePosition = { -1, -1 };
+		bool LastMouseDown = false;
+
+		bool IsIdle(Vector2 mousePosition, bool mouseDown) const;
+
+		void OnUpdateRequested() override { UpdateRequested = true; }
 
 		virtual void OnActivate() {}
 		virtual void OnDeactivate() {}
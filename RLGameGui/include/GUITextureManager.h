@@ -1,23 +1,137 @@
 #pragma once
 
 #include <string>
+#include <memory>
+#include <map>
+#include <vector>
+#include <cstdint>
 #include "raylib.h"
 #include "rlText.h"
 
 namespace RLGameGUI
 {
+    class GUIElement;
+
     namespace TextureManager
     {
         void SetResourceDir(const std::string& folderPath);
 
+        struct TextureEntry
+        {
+            std::string Name;
+            Texture2D Texture = { 0 };      // id 0 while loading, after a failed load or after an eviction
+            size_t Bytes = 0;               // GPU memory the texture takes
+            uint64_t LastUsedFrame = 0;
+            bool Pinned = false;            // handed out by name without a handle, never evicted
+
+            enum class States
+            {
+                Unloaded,
+                Loading,
+                Loaded,
+                Evicted,
+            };
+            States State = States::Unloaded;
+        };
+
+        // a texture that is held is never evicted, drop the handle to let the memory budget reclaim it
+        typedef std::shared_ptr<TextureEntry> TextureHandle;
+
+        TextureHandle AcquireTexture(const std::string& name);
+
+        // a texture that is still loading has an id of 0, which draws nothing
+        Texture2D GetTexture(const TextureHandle& handle);
+
+        // deprecated, pins the texture so it is never evicted, use AcquireTexture for textures the budget may reclaim
         Texture2D GetTexture(const std::string& name);
 
+        // textures are read and decoded on worker threads and only uploaded on the main thread, 0 threads uses one per core
+        // the workers decode with stb_image and never call raylib, formats it does not read are loaded by raylib when they are uploaded
+        // the thread count is only used when the workers first start
+        void SetAsyncLoading(bool enabled, int workerThreads = 0);
+
+        // how much ProcessLoads uploads in a call, at least one texture goes up each call so big ones are not stuck
+        // 0 seconds has no time limit
+        void SetUploadBudget(size_t bytesPerFrame, double secondsPerFrame = 0);
+
+        // uploads decoded textures within the budget, Manager::Update calls it every frame
+        // returns how many textures were uploaded, elements sized from a texture need a new layout when it is not 0
+        size_t ProcessLoads();
+
+        // textures requested but not uploaded yet
+        size_t GetPendingLoads();
+
+        // textures nothing holds and not drawn this frame are evicted, least recently drawn first, until the loaded ones fit in bytes
+        // held and pinned textures are never evicted, so the budget can be exceeded while they need more than it allows
+        // 0 never evicts
+        void SetMemoryBudget(size_t bytes);
+
+        // evicts down to the budget and starts a new frame, Manager::Render calls it after drawing
+        void NextFrame();
+
+        // 0 when the texture is not loaded
+        size_t GetTextureMemory(const std::string& name);
+
+        struct TextureStats
+        {
+            size_t Loaded = 0;
+            size_t Bytes = 0;
+            size_t Evictions = 0;
+            size_t Reloads = 0;             // evicted textures that were drawn again
+        };
+
+        const TextureStats& GetStats();
+
+        // held handles stay valid and reload on their next use
         void UnloadAll();
     }
 
     namespace FontManager
     {
-        rltFont GetFont(const std::string& name, float size);
+        // fonts stay at the same address for as long as a handle is held, UnloadAll releases their textures
+        typedef std::shared_ptr<const rltFont> FontHandle;
+
+        FontHandle GetFont(const std::string& name, float size);
+
+        // rasterized fonts are saved here and loaded back on later runs, empty turns the cache off
+        void SetCacheDir(const std::string& folderPath);
+
+        // every size of a font shares one SDF atlas rendered at baseSize, fonts already handed out are kept
+        void SetSDFFonts(bool enabled, float baseSize = 48);
+
+        // fonts loaded afterwards use one byte per pixel atlases, half the memory of the default gray alpha ones
+        void SetSingleChannelFonts(bool enabled);
+
+        // fonts loaded afterwards rasterize codepoints outside the standard set when they are first drawn, 0 turns it off
+        void SetGlyphCacheBudget(size_t bytesPerFont);
+
+        // fonts loaded afterwards are packed together onto shared textures of pageSize squared, so text in any of them can batch
+        void SetSharedAtlasPages(bool enabled, int pageSize = 2048);
+
+        struct FontStats
+        {
+            size_t FileReads = 0;       // one per font file, however many sizes are used
+            size_t SizesLoaded = 0;
+            size_t CacheHits = 0;
+            size_t CacheMisses = 0;
+            size_t AtlasPages = 0;      // shared pages the fonts are packed onto
+            double LoadSeconds = 0;     // compare a cold run to a warm one to see what the cache saves
+        };
+
+        const FontStats& GetStats();
+
+        // the glyphs each font name and size needs
+        typedef std::map<std::pair<std::string, float>, rltGlyphSet> GlyphSets;
+
+        // adds the text of every element under root, elements report it through GUIElement::CollectText
+        void CollectGlyphs(const GUIElement* root, GlyphSets& glyphSets);
+
+        // adds strings that any of the text may be swapped for, such as a localization table, to every set
+        void AddStringsToGlyphSets(const std::vector<std::string>& strings, GlyphSets& glyphSets);
+
+        // loads each font and size with only the glyphs in its set, sizes that are already loaded are left alone
+        // glyphs outside the set draw as the invalid glyph unless a glyph cache budget is set
+        void PreloadGlyphs(const GlyphSets& glyphSets);
 
         void UnloadAll();
     }
@@ -28,11 +28,14 @@
 
 #pragma once
 
+#include <charconv>
+
 #include "GUIElement.h"
 #include "raylib.h"
 #include "raymath.h"
 #include "GUIScreenIO.h"
 #include "rlText.h"
+#include "GUITextureManager.h"
 
 namespace RLGameGUI
 {
@@ -40,10 +43,13 @@ namespace RLGameGUI
     {
         std::string Name;
         bool Valid() const { return !Name.empty(); }
-        Texture2D GetTexture();
+
+        // owner is given a new layout when an async load that this record saw pending finishes, for elements sized from the texture
+        Texture2D GetTexture(GUIElement* owner = nullptr);
 
     private:
-        Texture2D Texture = { 0 };
+        TextureManager::TextureHandle Texture;
+        bool Pending = false;
     };
 
     struct FontRecord
@@ -51,10 +57,53 @@ namespace RLGameGUI
         std::string Name;
         float Size = 20;
 
-        rltFont GetFont();
+        // never null, falls back to the default font when the named font has no glyphs
+        const rltFont* GetFont();
 
     private:
-        rltFont CachedFont = { 0 };
+        FontManager::FontHandle Font;
+        std::string FontName;
+        float FontSize = 0;
+    };
+
+    struct TextLayoutRecord
+    {
+        rltTextLayout Layout;
+
+        // which of the Update functions built the layout
+        enum class LayoutModes
+        {
+            Plain,
+            Wrapped,
+            Truncated,
+        };
+
+        inline void Invalidate() { Dirty = true; }
+        inline bool IsCurrent(const rltFont* font, float size, LayoutModes mode = LayoutModes::Plain) const { return !Dirty && mode == Mode && font == Font && size == Size && Layout.GlyphCacheGeneration == rltGetGlyphCacheGeneration(font); }
+
+        // clamps the size to the smallest readable one and rebuilds the layout if anything changed
+        void Update(const std::string& text, float& size, const rltFont* font);
+
+        // same as Update with the text broken into lines no wider than width, a new width only breaks the lines it changes
+        void UpdateWrapped(const std::string& text, float& size, const rltFont* font, float width, rltAllignment allignment);
+
+        // same as Update with lines wider than width cut short with an ellipsis, a new width only moves the cut
+        void UpdateTruncated(const std::string& text, float& size, const rltFont* font, float width);
+
+        static constexpr float MinimumSize = 10;   // Default Font chars height in pixel
+
+    private:
+        bool Dirty = true;
+        const rltFont* Font = nullptr;
+        float Size = 0;
+        LayoutModes Mode = LayoutModes::Plain;
+
+        rltWrappedText Lines;
+        rltAllignment Allignment = rltAllignment::Left;
+
+        rltTextAdvances Advances;
+        std::string TruncatedText;
+        float TruncateWidth = 0;
     };
 
     enum class PanelFillModes
@@ -169,6 +218,12 @@ namespace RLGameGUI
 
         bool ClipToRectangle = true;
 
+        // breaks long text into lines at word boundaries to fit the label's width
+        bool WordWrap = false;
+
+        // ends text too wide for the label with an ellipsis, word wrap takes precedence
+        bool Truncate = false;
+
         GUILabel() {}
         GUILabel(const std::string& text) : Text(text) {}
         GUILabel(const std::string& text, const std::string& font, float size = 20)
@@ -186,18 +241,100 @@ namespace RLGameGUI
         AlignmentTypes HorizontalAlignment = AlignmentTypes::Minimum;
         AlignmentTypes VerticalAlignment = AlignmentTypes::Minimum;
 
-        inline virtual void SetText(const std::string& text) { Text = text; RelativeBounds.SetDirty(); }
+        inline virtual void SetText(const std::string& text) { Text = text; TextLayout.Invalidate(); InvalidateLayout(); }
         inline const std::string& GetText() { return Text; }
 
         bool Read(const rapidjson::Value& object, rapidjson::Document& document) override;
         bool Write(rapidjson::Value& object, rapidjson::Document& document) override;
 
+        void CollectText(const TextFunction& collect) const override;
+
     protected:
         void OnRender() override;
         void OnResize() override;
 
+        // the mode OnResize builds with, WordWrap and Truncate can change after the last resize
+        TextLayoutRecord::LayoutModes GetLayoutMode() const;
+
         std::string Text;
+        TextLayoutRecord TextLayout;
+
+        Rectangle TextRect = { 0,0,0,0 };
+    };
+
+    // Shows a number that changes every frame, like a score or timer, without allocating or laying out again
+    class GUINumberLabel : public GUIElement
+    {
+    public:
+        DEFINE_ELEMENT(GUINumberLabel)
+
+        Color Tint = BLACK;
+
+        FontRecord TextFont;
+
+        AlignmentTypes HorizontalAlignment = AlignmentTypes::Minimum;
+        AlignmentTypes VerticalAlignment = AlignmentTypes::Minimum;
+
+        // how float values are written, a negative precision gives the shortest text that reads back as the same value
+        std::chars_format FloatFormat = std::chars_format::fixed;
+        int Precision = 0;
 
+        // integer values are padded with zeros to at least this many digits
+        int MinimumDigits = 0;
+
+        GUINumberLabel();
+        GUINumberLabel(int value, const std::string& font, float size = 20);
+        GUINumberLabel(float value, int precision, const std::string& font, float size = 20);
+
+        typedef std::shared_ptr<GUINumberLabel> Ptr;
+        inline static Ptr Create() { return std::make_shared<GUINumberLabel>(); }
+        inline static Ptr Create(int value, const std::string& font, float size = 20) { return std::make_shared<GUINumberLabel>(value, font, size); }
+        inline static Ptr Create(float value, int precision, const std::string& font, float size = 20) { return std::make_shared<GUINumberLabel>(value, precision, font, size); }
+
+        // only the glyph quads are rewritten, the element and its parent keep their layout
+        void SetValue(int value);
+        void SetValue(float value);
+
+        inline bool IsFloat() const { return UseFloat; }
+        inline int GetIntValue() const { return IntValue; }
+        inline float GetFloatValue() const { return UseFloat ? FloatValue : float(IntValue); }
+
+        // the text the value is currently shown as
+        inline std::string_view GetText() const { return std::string_view(Buffer, Length); }
+
+        bool Read(const rapidjson::Value& object, rapidjson::Document& document) override;
+        bool Write(rapidjson::Value& object, rapidjson::Document& document) override;
+
+        // every character a number can be written with
+        void CollectText(const TextFunction& collect) const override;
+
+    protected:
+        void OnRender() override;
+        void OnResize() override;
+
+        void Format();
+        void BuildGlyphs(const rltFont* font);
+        void BuildQuads();
+
+        bool UseFloat = false;
+        int IntValue = 0;
+        float FloatValue = 0;
+
+        char Buffer[64] = { 0 };
+        size_t Length = 0;
+
+        // the quad and advance of each character a number uses, found once per font and size
+        struct NumberGlyph
+        {
+            rltTextQuad Quad;
+            float Advance = 0;
+            bool Valid = false;
+        };
+        NumberGlyph Glyphs[128];
+        const rltFont* GlyphFont = nullptr;
+        float GlyphSize = 0;
+
+        rltTextLayout Layout;
         Rectangle TextRect = { 0,0,0,0 };
     };
 
@@ -225,7 +362,7 @@ namespace RLGameGUI
         inline static Ptr Create(const std::string& text) { return std::make_shared<GUIButton>(text); }
         inline static Ptr Create(const std::string& text, const std::string& texture) { return std::make_shared<GUIButton>(text,texture); }
 
-        inline virtual void SetText(const std::string& text) { Text = text; RelativeBounds.SetDirty(); }
+        inline virtual void SetText(const std::string& text) { Text = text; TextLayout.Invalidate(); InvalidateLayout(); }
         inline const std::string& GetText() { return Text; }
 
         virtual void SetButtonFrames(int framesX, int framesY, int backgroundX, int backgroundY, int hoverX = -1, int hoverY = -1, int pressX = -1, int pressY = -1, int disableX = -1, int disableY = -1);
@@ -233,11 +370,14 @@ namespace RLGameGUI
         bool Read(const rapidjson::Value& object, rapidjson::Document& document) override;
         bool Write(rapidjson::Value& object, rapidjson::Document& document) override;
 
+        void CollectText(const TextFunction& collect) const override;
+
     protected:
         void OnResize() override;
         void OnRender() override;
 
         std::string Text;
+        TextLayoutRecord TextLayout;
 
         Rectangle TextRect = { 0,0,0,0 };
         float Spacing = 1;
@@ -280,6 +420,9 @@ namespace RLGameGUI
         bool Read(const rapidjson::Value& object, rapidjson::Document& document) override;
         bool Write(rapidjson::Value& object, rapidjson::Document& document) override;
 
+        // every item, in the font of the label that shows them
+        void CollectText(const TextFunction& collect) const override;
+
         void OnRender() override;
 
         GUIButton::Ptr IncrementButton = nullptr;
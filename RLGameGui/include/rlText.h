@@ -28,8 +28,10 @@ Use this as a starting point or replace it with your code.
 
 #include <set>
 #include <map>
+#include <memory>
 #include <vector>
 #include <string>
+#include <type_traits>
 
 struct rltGlyphInfo
 {
@@ -38,8 +40,24 @@ struct rltGlyphInfo
 	float       NextCharacterAdvance = 0;
 	Rectangle   SourceRect = { 0,0,0,0 };
 	Vector2		DestSize = { 0,0 };
+};
+
+static_assert(std::is_trivially_copyable_v<rltGlyphInfo>, "glyphs are copied in bulk");
+
+struct rltKerningPair
+{
+	int Left = 0;
+	int Right = 0;
+	float Advance = 0;
+};
+
+constexpr int rltKerningAsciiStart = 32;
+constexpr int rltKerningAsciiCount = 96;
 
-	std::map<int, float> KerningInfo;
+struct rltKerningTable
+{
+	std::vector<rltKerningPair> Pairs;	// sorted by left then right codepoint
+	std::vector<float> AsciiPairs;		// dense table for printable ASCII pairs, empty when none of them kern
 };
 
 struct rltGlyphRange
@@ -48,6 +66,24 @@ struct rltGlyphRange
 	std::vector<rltGlyphInfo> Glyphs;
 };
 
+constexpr int rltGlyphLookupSize = 256;
+
+struct rltGlyphIndex
+{
+	int Range = -1;
+	int Glyph = 0;
+};
+
+// glyphs rasterized on demand into a fixed block of atlas cells, see rltEnableGlyphCache
+struct rltGlyphCache;
+
+struct rltSkylineNode
+{
+	int X = 0;
+	int Y = 0;			// top of the free space above this span
+	int Width = 0;
+};
+
 struct rltFont
 {
 	float BaseSize = 0;
@@ -55,13 +91,30 @@ struct rltFont
 	float DefaultSpacing = 0;
 	float DefaultNewlineOffset = 0;
 	float Accent = 0;
-	std::vector<rltGlyphRange> Ranges;
+	std::vector<rltGlyphRange> Ranges;			// sorted by start codepoint
+	std::vector<rltGlyphIndex> GlyphLookup;		// direct map for Basic Latin and Latin-1, ranges are searched above that
+	rltKerningTable Kerning;
 
 	rltGlyphInfo InvalidGlyph;
 
 	Texture2D Texture = { 0 };
+	float AtlasFillRatio = 0;		// glyph pixels over atlas pixels
+	bool SDF = false;				// atlas holds distance fields, draws crisply at any size through the SDF shader
+
+	// CPU copy of the texture, glyphs added after loading are drawn here and only the changed area is uploaded
+	// mutable because the glyph cache rasterizes into it while drawing
+	mutable Image Atlas = { 0 };
+	mutable Rectangle AtlasDirtyRect = { 0,0,0,0 };
+
+	// glyphs added after loading are packed on this skyline, which starts below everything packed at load time
 	float LowestSourceRect = 0;
-	float LastSourceRectX = 0;
+	std::vector<rltSkylineNode> Skyline;
+
+	std::shared_ptr<rltGlyphCache> GlyphCache;	// set by rltEnableGlyphCache
+
+	// set by rltAddFontToAtlasPages, Texture is then a page shared with other fonts and the atlas sits at this offset in it
+	Vector2 AtlasOffset = { 0,0 };
+	bool SharedTexture = false;
 };
 
 const rltFont& rltGetDefaultFont();
@@ -72,20 +125,128 @@ void rltGetStandardGlyphSet(rltGlyphSet& glyphSet);
 void rltAddRangeToGlyphSet(int start, int end, rltGlyphSet& glyphSet);
 void rltAddGlyphSetFromString(std::string_view text, rltGlyphSet& glyphSet);
 
-rltFont rltLoadFontTTF(std::string_view filePath, float fontSize, const rltGlyphSet* glyphSet = nullptr, float* defaultSpacing = nullptr);
-rltFont rltLoadFontTTFMemory(const void* data, size_t dataSize, float fontSize, const rltGlyphSet* glyphSet = nullptr, float* defaultSpacing = nullptr);
+struct rltFontLoadOptions
+{
+	bool PowerOfTwoAtlas = true;	// turn off where the GPU takes any texture size
+	int MaxAtlasSize = 4096;
+	int WorkerThreads = 0;			// threads used to render glyphs, 0 uses one per core and 1 stays on the calling thread
+	bool SDF = false;				// render signed distance fields instead of coverage
+	bool SingleChannel = false;		// one byte per pixel atlas, drawn through a shader that reads coverage from red
+};
+
+// a parsed font file that any number of sizes can be loaded from without reading the file again
+struct rltFontFace;
+
+rltFontFace* rltLoadFontFace(std::string_view filePath);
+rltFontFace* rltLoadFontFaceMemory(const void* data, size_t dataSize);
+void rltUnloadFontFace(rltFontFace* face);
+
+// hash of the file a face was loaded from
+unsigned int rltGetFontFaceHash(const rltFontFace* face);
+unsigned int rltHashGlyphSet(const rltGlyphSet& glyphSet);
+
+// the pixel scale fonts are rasterized at, more than 1 on high DPI windows
+float rltGetRasterScale();
+
+rltFont rltLoadFontFromFace(const rltFontFace* face, float fontSize, const rltGlyphSet* glyphSet = nullptr, float* defaultSpacing = nullptr, const rltFontLoadOptions* options = nullptr);
+
+rltFont rltLoadFontTTF(std::string_view filePath, float fontSize, const rltGlyphSet* glyphSet = nullptr, float* defaultSpacing = nullptr, const rltFontLoadOptions* options = nullptr);
+rltFont rltLoadFontTTFMemory(const void* data, size_t dataSize, float fontSize, const rltGlyphSet* glyphSet = nullptr, float* defaultSpacing = nullptr, const rltFontLoadOptions* options = nullptr);
 
 void rltUnloadFont(rltFont* font);
 
+// everything that changes the rasterized font, a cache file only loads for the key it was saved with
+struct rltFontCacheKey
+{
+	unsigned int FileHash = 0;
+	float Size = 0;
+	unsigned int GlyphSetHash = 0;
+	float RasterScale = 1;
+	bool SDF = false;
+	bool SingleChannel = false;
+	bool PowerOfTwoAtlas = true;
+	int MaxAtlasSize = 4096;
+	float DefaultSpacing = 0;		// the spacing the font was loaded with, size / 10 when none was passed
+};
+
+// saves the atlas pixels, glyph metrics, ranges and kerning of a loaded font
+bool rltSaveFontCache(const rltFont* font, const rltFontCacheKey& key, std::string_view filePath);
+bool rltLoadFontCache(rltFont* font, const rltFontCacheKey& key, std::string_view filePath);
+
+// call after changing a font's ranges directly
+void rltRebuildGlyphLookup(rltFont* font);
+
+// sorts the pairs, later duplicates win, and builds the ASCII table
+void rltSetFontKerning(rltFont* font, std::vector<rltKerningPair>& pairs);
+float rltGetKerning(const rltFont* font, int left, int right);
+
 bool rltFontHasCodepoint(rltFont* font, int codepoint);
 bool rltFontHasAllGlyphsInString(rltFont* font, std::string_view text);
 
 bool rltAddGlpyhToFont(rltFont* font, int codepoint, Image& glpyhImage, const Vector2& offeset = Vector2Zeros, float advance = -1);
 
+// uploads glyphs added since the last call in one transfer, drawing text does this on its own
+void rltUpdateFontTexture(const rltFont* font);
+
+// fixed size textures that the atlases of many fonts are packed into, so text in different faces and sizes can share a draw call
+struct rltAtlasPage
+{
+	Texture2D Texture = { 0 };
+	bool SDF = false;
+	std::vector<rltSkylineNode> Skyline;
+};
+
+struct rltAtlasPages
+{
+	int PageSize = 2048;
+	std::vector<rltAtlasPage> Pages;
+};
+
+// moves the font's atlas, trimmed to the glyphs in it, onto a page of the same kind with room for it, adding a page when none has
+// false when the atlas is bigger than a page, the font then keeps its own texture
+// glyphs can't be added to the font afterwards, enable a glyph cache first if it needs one
+bool rltAddFontToAtlasPages(rltFont* font, rltAtlasPages& pages);
+
+// unload the fonts on the pages first
+void rltUnloadAtlasPages(rltAtlasPages& pages);
+
+// grows the atlas by budgetBytes of fixed size cells that codepoints missing from the font are rasterized into when drawn
+// the least recently used glyphs are evicted once the cells are full, the face must outlive the font
+bool rltEnableGlyphCache(rltFont* font, const rltFontFace* face, size_t budgetBytes);
+
+struct rltGlyphCacheStats
+{
+	size_t Cells = 0;
+	size_t Hits = 0;
+	size_t Misses = 0;			// glyphs rasterized on demand
+	size_t Evictions = 0;
+	size_t Failures = 0;		// codepoints the face lacks, glyphs too big for a cell, or every cell used this frame
+};
+
+// nullptr when the font has no glyph cache
+const rltGlyphCacheStats* rltGetGlyphCacheStats(const rltFont* font);
+
+// changes whenever a cached glyph is evicted, layouts built before that may point at a reused cell
+unsigned int rltGetGlyphCacheGeneration(const rltFont* font);
+
+// glyphs drawn since the last call are never evicted, call once per frame after everything is drawn
+void rltNextGlyphCacheFrame();
+
 void rltDrawText(std::string_view text, float size, const Vector2& position, Color tint, const rltFont* font = nullptr);
 
 void rltSetTextYFlip(bool flip = true);
 
+// shader is nullptr when the glyph draws with the default shader
+typedef void (*rltGlyphDrawFunction)(const Texture2D& texture, const Rectangle& source, const Rectangle& dest, Color tint, const Shader* shader);
+
+// replaces the DrawTexturePro call made for each glyph, nullptr restores it
+void rltSetGlyphDrawFunction(rltGlyphDrawFunction function);
+
+// the shader SDF and single channel atlases are drawn with, nullptr for plain gray alpha atlases
+// loaded on first use, unload before closing the window
+const Shader* rltGetFontShader(const Texture2D& texture, bool sdf);
+void rltUnloadFontShaders();
+
 enum class rltAllignment
 {
 	Left,
@@ -97,4 +258,121 @@ void rltDrawTextJustified(std::string_view text, float size, const Vector2& posi
 
 float rltDrawTextWrapped(std::string_view text, float size, const Vector2& position, float width, Color tint, const rltFont* font = nullptr);
 
-Vector2 rltMeasureText(std::string_view text, float size, const rltFont* font = nullptr);
\ No newline at end of file
+Vector2 rltMeasureText(std::string_view text, float size, const rltFont* font = nullptr);
+
+// the width of every prefix of each line, so fitting and hit testing are a binary search instead of measuring again
+struct rltTextAdvances
+{
+	std::vector<size_t> Offsets;	// byte offset of each caret stop, before the glyph and any colour escape leading up to it
+	std::vector<float> Advances;	// width of the line up to each stop, kerning included
+	std::vector<size_t> Lines;		// index of the first stop of each line, the last stop of a line is its end
+	float LineHeight = 0;
+	Vector2 Size = { 0,0 };
+};
+
+void rltBuildTextAdvances(rltTextAdvances& advances, std::string_view text, float size, const rltFont* font = nullptr);
+
+// the byte offset of the caret stop nearest a point relative to the text origin
+size_t rltGetTextOffsetAt(const rltTextAdvances& advances, const Vector2& point);
+
+// the top of the caret at a byte offset, relative to the text origin
+Vector2 rltGetCaretPosition(const rltTextAdvances& advances, size_t offset);
+
+// one rectangle for each line the byte range covers
+void rltGetSelectionRects(const rltTextAdvances& advances, size_t start, size_t end, std::vector<Rectangle>& rects);
+
+// the byte offset the longest prefix of a line no wider than width ends at
+size_t rltFitTextWidth(const rltTextAdvances& advances, size_t line, float width);
+
+// cuts each line wider than width and ends it with the ellipsis, returns false when nothing was cut
+// the advances must be built from the same text, size and font
+bool rltTruncateText(std::string& truncated, std::string_view text, const rltTextAdvances& advances, float width, float size, const rltFont* font = nullptr, std::string_view ellipsis = "...");
+
+struct rltTextQuad
+{
+	Rectangle Source = { 0,0,0,0 };
+	Rectangle Dest = { 0,0,0,0 };	// relative to the layout origin
+	Color Tint = WHITE;
+	bool UseTint = true;			// false once a colour escape has set the colour
+};
+
+struct rltTextLayout
+{
+	std::vector<rltTextQuad> Quads;
+	Texture2D Texture = { 0 };
+	Vector2 Size = { 0,0 };			// what rltMeasureText returns for the text
+	bool SDF = false;
+	unsigned int GlyphCacheGeneration = 0;
+};
+
+// positions every glyph once, so unchanged text can be drawn without decoding it again
+void rltBuildTextLayout(rltTextLayout& layout, std::string_view text, float size, const rltFont* font = nullptr);
+void rltDrawTextLayout(const rltTextLayout& layout, const Vector2& position, Color tint);
+
+// the quad of one glyph with its origin at the pen and how far it moves the pen, for text assembled from a few known glyphs
+// false for codepoints that draw nothing
+bool rltGetGlyphQuad(rltTextQuad& quad, float& advance, int codepoint, float size, const rltFont* font = nullptr);
+
+// a run of codepoints drawn the same way
+struct rltTextSpan
+{
+	size_t Start = 0;				// index into rltCompiledText::Codepoints
+	size_t Count = 0;
+	Color Tint = WHITE;
+	bool UseTint = true;			// false once a colour escape has set the colour
+	const rltFont* Font = nullptr;	// nullptr for the font the text is drawn with
+	float Size = 0;					// 0 for the size the text is drawn with
+};
+
+// text with its colour escapes parsed and its UTF-8 decoded, so drawing and measuring it does neither
+struct rltCompiledText
+{
+	std::vector<int> Codepoints;
+	std::vector<rltTextSpan> Spans;
+};
+
+void rltCompileText(rltCompiledText& compiled, std::string_view text);
+
+// adds text after what is already compiled, font and size switch to another font or size for just this text
+void rltAppendCompiledText(rltCompiledText& compiled, std::string_view text, const rltFont* font = nullptr, float size = 0);
+
+void rltDrawCompiledText(const rltCompiledText& compiled, float size, const Vector2& position, Color tint, const rltFont* font = nullptr);
+Vector2 rltMeasureCompiledText(const rltCompiledText& compiled, float size, const rltFont* font = nullptr);
+bool rltFontHasAllGlyphsInCompiledText(const rltFont* font, const rltCompiledText& compiled);
+
+struct rltTextWord
+{
+	size_t Start = 0;				// byte offsets into the text
+	size_t End = 0;
+	float Width = 0;
+	float SpaceWidth = 0;			// the spaces after the word, only counted when another word follows on the line
+	bool BreakAfter = false;		// a newline follows
+};
+
+struct rltTextLine
+{
+	size_t Start = 0;				// byte offsets into the text, the spaces and newline that end the line are left out
+	size_t End = 0;
+	float Width = 0;
+	size_t FirstWord = 0;
+	size_t WordCount = 0;
+	float NextWordWidth = -1;		// what the next word would add to this line, -1 when a newline or the end of the text ends it
+};
+
+struct rltWrappedText
+{
+	std::vector<rltTextWord> Words;
+	std::vector<rltTextLine> Lines;
+	float Width = 0;				// the width the lines were broken at
+	float LineHeight = 0;
+	Vector2 Size = { 0,0 };			// widest line by the height of all of them
+};
+
+// measures each word once and breaks lines between words, a word wider than the width gets a line to itself
+void rltBuildWrappedText(rltWrappedText& wrapped, std::string_view text, float size, float width, const rltFont* font = nullptr);
+
+// breaks the lines again for a new width without measuring, lines before the first one the width changes are kept
+void rltReflowWrappedText(rltWrappedText& wrapped, float width);
+
+// a layout of the wrapped lines, each aligned inside the widest one
+void rltBuildWrappedTextLayout(rltTextLayout& layout, std::string_view text, const rltWrappedText& wrapped, float size, rltAllignment allignment = rltAllignment::Left, const rltFont* font = nullptr);
@@ -27,7 +27,16 @@ Use this as a starting point or replace it with your code.
 #include "raymath.h"
 
 #include <map>
-
+#include <unordered_map>
+#include <unordered_set>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
 #include "external/stb_rect_pack.h"     // Required for: ttf/bdf font rectangles packaging
 
 #define STBTT_STATIC
@@ -43,6 +52,114 @@ void rltSetTextYFlip(bool flip)
 	TextIsYFlipped = flip;
 }
 
+static rltGlyphDrawFunction GlyphDrawFunction = nullptr;
+
+#if defined(GRAPHICS_API_OPENGL_ES2) || defined(GRAPHICS_API_OPENGL_ES3)
+static const char* FontShaderHeader = R"(#version 100
+#extension GL_OES_standard_derivatives : enable
+precision mediump float;
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+#define SAMPLE texture2D
+#define OUTPUT gl_FragColor
+)";
+#else
+static const char* FontShaderHeader = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+out vec4 finalColor;
+#define SAMPLE texture
+#define OUTPUT finalColor
+)";
+#endif
+
+static const char* SDFShaderBody = R"(uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+void main()
+{
+	float distanceFromOutline = SAMPLE(texture0, fragTexCoord).COVERAGE - 0.5;
+	float distanceChangePerFragment = length(vec2(dFdx(distanceFromOutline), dFdy(distanceFromOutline)));
+	float alpha = smoothstep(-distanceChangePerFragment, distanceChangePerFragment, distanceFromOutline);
+	OUTPUT = vec4(fragColor.rgb, fragColor.a * alpha) * colDiffuse;
+}
+)";
+
+static const char* CoverageShaderBody = R"(uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+void main()
+{
+	OUTPUT = vec4(fragColor.rgb, fragColor.a * SAMPLE(texture0, fragTexCoord).COVERAGE) * colDiffuse;
+}
+)";
+
+enum class FontShaderType
+{
+	SDF = 0,
+	SingleChannelSDF,
+	SingleChannel,
+	Count,
+};
+
+static Shader FontShaders[int(FontShaderType::Count)] = { 0 };
+
+const Shader* rltGetFontShader(const Texture2D& texture, bool sdf)
+{
+	// single channel atlases hold coverage in red, the others in alpha
+	bool singleChannel = texture.format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+	if (!sdf && !singleChannel)
+		return nullptr;
+
+	FontShaderType type = sdf ? (singleChannel ? FontShaderType::SingleChannelSDF : FontShaderType::SDF) : FontShaderType::SingleChannel;
+
+	Shader& shader = FontShaders[int(type)];
+	if (shader.id == 0)
+	{
+		std::string source = FontShaderHeader;
+		source += singleChannel ? "#define COVERAGE r\n" : "#define COVERAGE a\n";
+		source += sdf ? SDFShaderBody : CoverageShaderBody;
+
+		shader = LoadShaderFromMemory(nullptr, source.c_str());
+	}
+
+	return &shader;
+}
+
+void rltUnloadFontShaders()
+{
+	for (auto& shader : FontShaders)
+	{
+		if (shader.id != 0)
+			UnloadShader(shader);
+
+		shader = Shader{ 0 };
+	}
+}
+
+// immediate drawing needs the shader around the glyphs, a glyph draw function gets it per quad instead
+static bool BeginFontShader(const Texture2D& texture, bool sdf)
+{
+	if (GlyphDrawFunction)
+		return false;
+
+	const Shader* shader = rltGetFontShader(texture, sdf);
+	if (!shader)
+		return false;
+
+	BeginShaderMode(*shader);
+	return true;
+}
+
+static void EndFontShader(bool begun)
+{
+	if (begun)
+		EndShaderMode();
+}
+
+void rltSetGlyphDrawFunction(rltGlyphDrawFunction function)
+{
+	GlyphDrawFunction = function;
+}
+
 #define REUSE_DEFAULT_TEXTUREID 1
 
 void LoadDefaultFont()
@@ -195,6 +312,8 @@ void LoadDefaultFont()
 	}
 	DefaultFont.LowestSourceRect = float(imFont.height);
 	UnloadImage(imFont);
+
+	rltRebuildGlyphLookup(&DefaultFont);
 }
 
 const rltFont& rltGetDefaultFont()
@@ -228,21 +347,349 @@ void rltAddGlyphSetFromString(std::string_view text, rltGlyphSet& glyphSet)
 	}
 }
 
-rltFont rltLoadFontTTF(std::string_view filePath, float fontSize, const rltGlyphSet* glyphSet, float* defaultSpacing)
+struct GlyphRaster
+{
+	int Codepoint = 0;
+	int Width = 0;
+	int Height = 0;
+	bool Blank = false;
+	int AtlasX = 0;
+	int AtlasY = 0;
+};
+
+// same settings raylib uses for its SDF fonts
+static constexpr int SDFPadding = 4;
+static constexpr unsigned char SDFOnEdgeValue = 128;
+static constexpr float SDFDistanceScale = 64.0f;
+
+// single channel atlases take the row as is, gray alpha ones get full white colour under the coverage
+static void CopyCoverageRow(const unsigned char* sourceRow, const GlyphRaster& raster, int y, int width, Image& atlas)
+{
+	if (atlas.format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE)
+	{
+		memcpy(((unsigned char*)atlas.data) + size_t(raster.AtlasY + y) * atlas.width + raster.AtlasX, sourceRow, width);
+		return;
+	}
+
+	unsigned char* destRow = ((unsigned char*)atlas.data) + (size_t(raster.AtlasY + y) * atlas.width + raster.AtlasX) * 2;
+	for (int x = 0; x < width; x++)
+	{
+		destRow[x * 2] = 255;
+		destRow[x * 2 + 1] = sourceRow[x];
+	}
+}
+
+static void CopySDFGlyph(const stbtt_fontinfo& fontInfo, float scale, const GlyphRaster& raster, Image& atlas)
+{
+	int width = 0, height = 0, offsetX = 0, offsetY = 0;
+	unsigned char* distances = stbtt_GetCodepointSDF(&fontInfo, scale, raster.Codepoint, SDFPadding, SDFOnEdgeValue, SDFDistanceScale, &width, &height, &offsetX, &offsetY);
+	if (!distances)
+		return;
+
+	int copyWidth = std::min(width, raster.Width);
+	int copyHeight = std::min(height, raster.Height);
+
+	for (int y = 0; y < copyHeight; y++)
+		CopyCoverageRow(distances + size_t(y) * width, raster, y, copyWidth, atlas);
+
+	stbtt_FreeSDF(distances, nullptr);
+}
+
+static void RasterizeGlyphRange(const stbtt_fontinfo& fontInfo, float scale, bool sdf, const GlyphRaster* rasters, size_t count, Image& atlas, std::vector<unsigned char>& scratch)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const GlyphRaster& raster = rasters[i];
+		if (raster.Blank || raster.Width <= 0 || raster.Height <= 0)
+			continue;
+
+		if (sdf)
+		{
+			CopySDFGlyph(fontInfo, scale, raster, atlas);
+			continue;
+		}
+
+		scratch.resize(size_t(raster.Width) * raster.Height);
+		stbtt_MakeCodepointBitmap(&fontInfo, scratch.data(), raster.Width, raster.Height, raster.Width, scale, scale, raster.Codepoint);
+
+		for (int y = 0; y < raster.Height; y++)
+			CopyCoverageRow(scratch.data() + size_t(y) * raster.Width, raster, y, raster.Width, atlas);
+	}
+}
+
+// fills in the metrics of one glyph and the size of its bitmap, nothing is rendered
+static void MeasureGlyph(const stbtt_fontinfo& fontInfo, int codepoint, float scaleFactor, int ascent, float rasterScale, float effectivefontSize, bool sdf, rltGlyphInfo& glyphInfo, GlyphRaster& raster)
+{
+	int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+	stbtt_GetCodepointBitmapBox(&fontInfo, codepoint, scaleFactor, scaleFactor, &x0, &y0, &x1, &y1);
+
+	raster.Codepoint = codepoint;
+	// SDF glyphs carry a border for the distance to fall off in, empty glyphs get no bitmap at all
+	if (sdf && x0 != x1 && y0 != y1)
+	{
+		x0 -= SDFPadding;
+		y0 -= SDFPadding;
+		x1 += SDFPadding;
+		y1 += SDFPadding;
+	}
+
+	raster.Width = x1 - x0;
+	raster.Height = y1 - y0;
+
+	int offsetX = x0;
+	int offsetY = y0;
+
+	int advanceX = 0;
+	stbtt_GetCodepointHMetrics(&fontInfo, codepoint, &advanceX, nullptr);
+	glyphInfo.Value = codepoint;
+	glyphInfo.NextCharacterAdvance = (advanceX * scaleFactor) / rasterScale;
+
+	// backplot the offsets into world space
+	glyphInfo.Offset.x = offsetX / rasterScale;
+	offsetY += int(ascent * scaleFactor);
+	glyphInfo.Offset.y = offsetY / rasterScale;
+
+	if (codepoint == 32)
+	{
+		raster.Blank = true;
+		raster.Width = int(glyphInfo.NextCharacterAdvance);
+		raster.Height = int(effectivefontSize);
+	}
+
+	glyphInfo.DestSize.x = raster.Width / rasterScale;
+	glyphInfo.DestSize.y = raster.Height / rasterScale;
+}
+
+// renders every glyph into its packed spot, the spots don't overlap so the workers never touch the same pixels
+static void RasterizeGlyphs(const stbtt_fontinfo& fontInfo, float scale, bool sdf, const std::vector<GlyphRaster>& rasters, Image& atlas, int workerCount)
+{
+	const size_t glyphsPerChunk = 16;
+
+	if (workerCount <= 0)
+		workerCount = int(std::thread::hardware_concurrency());
+
+	// not worth starting threads for a handful of glyphs
+	workerCount = std::min(workerCount, int(rasters.size() / (glyphsPerChunk * 2)));
+
+	if (workerCount <= 1)
+	{
+		std::vector<unsigned char> scratch;
+		RasterizeGlyphRange(fontInfo, scale, sdf, rasters.data(), rasters.size(), atlas, scratch);
+		return;
+	}
+
+	std::atomic<size_t> nextGlyph{ 0 };
+
+	auto worker = [&]()
+		{
+			std::vector<unsigned char> scratch;
+			while (true)
+			{
+				size_t first = nextGlyph.fetch_add(glyphsPerChunk);
+				if (first >= rasters.size())
+					break;
+
+				size_t count = std::min(glyphsPerChunk, rasters.size() - first);
+				RasterizeGlyphRange(fontInfo, scale, sdf, rasters.data() + first, count, atlas, scratch);
+			}
+		};
+
+	std::vector<std::thread> threads;
+	for (int i = 1; i < workerCount; i++)
+		threads.emplace_back(worker);
+
+	worker();
+
+	for (auto& thread : threads)
+		thread.join();
+}
+
+static int NextPowerOfTwo(int value)
+{
+	int result = 1;
+	while (result < value)
+		result <<= 1;
+	return result;
+}
+
+// packs the rects into the smallest atlas the options allow, returns a zero size if they can't fit
+static Vector2 PackAtlas(std::vector<stbrp_rect>& rects, const rltFontLoadOptions& options)
+{
+	int totalArea = 0;
+	int maxWidth = 0;
+	for (auto& rect : rects)
+	{
+		totalArea += rect.w * rect.h;
+		maxWidth = std::max(maxWidth, rect.w);
+	}
+
+	// candidate widths, each packed into the tallest allowed atlas to see how much height it really needs
+	std::vector<int> widths;
+	if (options.PowerOfTwoAtlas)
+	{
+		for (int width = NextPowerOfTwo(maxWidth); width <= options.MaxAtlasSize; width <<= 1)
+			widths.push_back(width);
+	}
+	else
+	{
+		const int step = 16;
+		int idealWidth = int(sqrtf(float(totalArea)));
+		int first = std::max(maxWidth, idealWidth / 2);
+		int last = std::min(options.MaxAtlasSize, idealWidth * 2 + maxWidth);
+		for (int width = ((first + step - 1) / step) * step; width <= last; width += step)
+			widths.push_back(width);
+	}
+
+	std::vector<stbrp_node> nodes;
+	stbrp_context context;
+
+	int bestWidth = 0;
+	int bestHeight = 0;
+
+	for (int width : widths)
+	{
+		if (width * options.MaxAtlasSize < totalArea)
+			continue;
+
+		nodes.resize(width);
+		stbrp_init_target(&context, width, options.MaxAtlasSize, nodes.data(), int(nodes.size()));
+		if (!stbrp_pack_rects(&context, rects.data(), int(rects.size())))
+			continue;
+
+		int usedHeight = 0;
+		for (auto& rect : rects)
+			usedHeight = std::max(usedHeight, rect.y + rect.h);
+
+		int height = options.PowerOfTwoAtlas ? NextPowerOfTwo(usedHeight) : usedHeight;
+
+		// prefer the smaller area, then the squarer atlas
+		if (bestWidth == 0 || width * height < bestWidth * bestHeight || (width * height == bestWidth * bestHeight && std::max(width, height) < std::max(bestWidth, bestHeight)))
+		{
+			bestWidth = width;
+			bestHeight = height;
+		}
+	}
+
+	if (bestWidth == 0)
+		return Vector2Zeros;
+
+	// pack again so the rects hold the winning layout
+	nodes.resize(bestWidth);
+	stbrp_init_target(&context, bestWidth, bestHeight, nodes.data(), int(nodes.size()));
+	stbrp_pack_rects(&context, rects.data(), int(rects.size()));
+
+	return Vector2{ float(bestWidth), float(bestHeight) };
+}
+
+float rltGetRasterScale()
+{
+	// if we are auto scaling for high DPI, load the font at the scaled size, so that the pixel map is the right size
+	if (IsWindowState(FLAG_WINDOW_HIGHDPI))
+		return GetWindowScaleDPI().y;
+
+	return 1.0f;
+}
+
+struct rltFontFace
+{
+	unsigned int Hash = 0;
+	std::vector<unsigned char> OwnedData;
+	stbtt_fontinfo Info = { 0 };
+	std::vector<stbtt_kerningentry> Kerning;	// in font units, scaled for each size that is loaded
+};
+
+static bool InitFontFace(rltFontFace& face, const unsigned char* data)
+{
+	if (!data || !stbtt_InitFont(&face.Info, data, 0))
+		return false;
+
+	int tableSize = stbtt_GetKerningTableLength(&face.Info);
+	face.Kerning.resize(tableSize);
+	if (tableSize > 0)
+		stbtt_GetKerningTable(&face.Info, face.Kerning.data(), tableSize);
+
+	return true;
+}
+
+rltFontFace* rltLoadFontFace(std::string_view filePath)
+{
+	int dataSize = 0;
+	unsigned char* fileData = LoadFileData(filePath.data(), &dataSize);
+	if (!fileData)
+		return nullptr;
+
+	rltFontFace* face = rltLoadFontFaceMemory(fileData, size_t(dataSize));
+
+	UnloadFileData(fileData);
+
+	return face;
+}
+
+rltFontFace* rltLoadFontFaceMemory(const void* data, size_t dataSize)
+{
+	if (!data || dataSize == 0)
+		return nullptr;
+
+	rltFontFace* face = new rltFontFace();
+	face->OwnedData.assign((const unsigned char*)data, (const unsigned char*)data + dataSize);
+
+	if (!InitFontFace(*face, face->OwnedData.data()))
+	{
+		delete face;
+		return nullptr;
+	}
+
+	face->Hash = ComputeCRC32(face->OwnedData.data(), int(face->OwnedData.size()));
+
+	return face;
+}
+
+void rltUnloadFontFace(rltFontFace* face)
+{
+	delete face;
+}
+
+unsigned int rltGetFontFaceHash(const rltFontFace* face)
+{
+	return face ? face->Hash : 0;
+}
+
+unsigned int rltHashGlyphSet(const rltGlyphSet& glyphSet)
+{
+	std::vector<int> codepoints(glyphSet.begin(), glyphSet.end());
+	if (codepoints.empty())
+		return 0;
+
+	return ComputeCRC32((unsigned char*)codepoints.data(), int(codepoints.size() * sizeof(int)));
+}
+
+rltFont rltLoadFontTTF(std::string_view filePath, float fontSize, const rltGlyphSet* glyphSet, float* defaultSpacing, const rltFontLoadOptions* options)
 {
 	int dataSize = 0;
 	unsigned char* fileData = LoadFileData(filePath.data(), &dataSize);
 
-	auto font = rltLoadFontTTFMemory(fileData, dataSize, fontSize, glyphSet, defaultSpacing);
+	auto font = rltLoadFontTTFMemory(fileData, dataSize, fontSize, glyphSet, defaultSpacing, options);
 
 	UnloadFileData(fileData);
 
 	return font;
 }
 
-rltFont rltLoadFontTTFMemory(const void* data, size_t dataSize, float fontSize, const rltGlyphSet* glyphSet, float* defaultSpacing)
+rltFont rltLoadFontTTFMemory(const void* data, size_t dataSize, float fontSize, const rltGlyphSet* glyphSet, float* defaultSpacing, const rltFontLoadOptions* options)
+{
+	// a face over the callers data, it only lives for this load
+	rltFontFace face;
+	if (!InitFontFace(face, (const unsigned char*)data))
+		return rltFont();
+
+	return rltLoadFontFromFace(&face, fontSize, glyphSet, defaultSpacing, options);
+}
+
+rltFont rltLoadFontFromFace(const rltFontFace* face, float fontSize, const rltGlyphSet* glyphSet, float* defaultSpacing, const rltFontLoadOptions* options)
 {
 	rltFont font;
+	if (!face)
+		return font;
 
 	font.BaseSize = fontSize;
 	font.DefaultNewlineOffset = fontSize * 1.2f;
@@ -258,16 +705,17 @@ rltFont rltLoadFontTTFMemory(const void* data, size_t dataSize, float fontSize,
 		rltGetStandardGlyphSet(defaultSet);
 		setTouse = &defaultSet;
 	}
-	stbtt_fontinfo fontInfo = { 0 };
-	if (!stbtt_InitFont(&fontInfo, (unsigned char*)data, 0))
-		return font;
+	const stbtt_fontinfo& fontInfo = face->Info;
+
+	rltFontLoadOptions loadOptions;
+	if (options)
+		loadOptions = *options;
+
+	font.SDF = loadOptions.SDF;
 
 	std::map<int, int> indexToCodepoint;
 
-	float rasterScale = 1.0f;
-	// if we are auto scaling for high DPI, load the font at the scaled size, so that the pixel map is the right size
-	if (IsWindowState(FLAG_WINDOW_HIGHDPI))
-		rasterScale = GetWindowScaleDPI().y;
+	float rasterScale = rltGetRasterScale();
 
 	float effectivefontSize = fontSize * rasterScale;
 
@@ -284,7 +732,7 @@ rltFont rltLoadFontTTFMemory(const void* data, size_t dataSize, float fontSize,
 
 	rltGlyphRange* currentRange = nullptr;
 
-	std::map<int, Image> glyphImages;
+	std::vector<GlyphRaster> rasters;
 
 	for (auto& codepoint : *setTouse)
 	{
@@ -304,56 +752,19 @@ rltFont rltLoadFontTTFMemory(const void* data, size_t dataSize, float fontSize,
 		auto& glyphInfo = currentRange->Glyphs.emplace_back();
 		glyphInfo.Value = codepoint;
 
-		Image glyphImage = { 0 };
-
-		int offsetX = 0;
-		int offsetY = 0;
-		glyphImage.data = stbtt_GetCodepointBitmap(&fontInfo,
-			scaleFactor,
-			scaleFactor,
-			codepoint,
-			&glyphImage.width,
-			&glyphImage.height,
-			&offsetX,
-			&offsetY);
-
-		int advanceX = 0;
-		stbtt_GetCodepointHMetrics(&fontInfo, codepoint, &advanceX, nullptr);
-		glyphInfo.NextCharacterAdvance = (advanceX * scaleFactor) / rasterScale;
-
-		// backplot the offsets into world space
-		glyphInfo.Offset.x = offsetX / rasterScale;
-		offsetY += int(ascent * scaleFactor);
-		glyphInfo.Offset.y = offsetY / rasterScale;
-
-		if (codepoint == 32)
-		{
-			if (glyphImage.data)
-				MemFree(glyphImage.data);
-
-			glyphImage.width = int(glyphInfo.NextCharacterAdvance);
-			glyphImage.height = int(effectivefontSize);
-
-			glyphImage.data = MemAlloc(glyphImage.width * glyphImage.height);
-		}
-		glyphImage.mipmaps = 1;
-		glyphImage.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+		// only measure here, the bitmaps are rendered straight into the atlas once it is packed
+		GlyphRaster raster;
+		MeasureGlyph(fontInfo, codepoint, scaleFactor, ascent, rasterScale, effectivefontSize, font.SDF, glyphInfo, raster);
 
-		glyphInfo.DestSize.x = glyphImage.width / rasterScale;
-		glyphInfo.DestSize.y = glyphImage.height / rasterScale;
-
-		// we will composite this later
-		glyphImages.insert_or_assign(codepoint, glyphImage);
+		rasters.push_back(raster);
 	}
 
 	// kerning table
 
-	auto tableSize = stbtt_GetKerningTableLength(&fontInfo);
-	std::vector<stbtt_kerningentry> kerningTable(tableSize);
-
-	stbtt_GetKerningTable(&fontInfo, kerningTable.data(), tableSize);
+	std::vector<rltKerningPair> kerningPairs;
+	kerningPairs.reserve(face->Kerning.size());
 
-	for (auto& entry : kerningTable)
+	for (auto& entry : face->Kerning)
 	{
 		auto fromGlyphItr = indexToCodepoint.find(entry.glyph1);
 		auto toGlyphItr = indexToCodepoint.find(entry.glyph2);
@@ -361,135 +772,92 @@ rltFont rltLoadFontTTFMemory(const void* data, size_t dataSize, float fontSize,
 		if (fromGlyphItr == indexToCodepoint.end() || toGlyphItr == indexToCodepoint.end())
 			continue;
 
-		int fromCodepoint = fromGlyphItr->second;
-		int toCodepoint = toGlyphItr->second;
-
-		rltGlyphInfo* fromGlyph = nullptr;
-
-		for (auto& range : font.Ranges)
-		{
-			if (fromCodepoint < range.Start || fromCodepoint >(range.Start + range.Glyphs.size()))
-				continue;
-
-			fromGlyph = &range.Glyphs[fromCodepoint - range.Start];
-			break;
-		}
-
-		if (!fromGlyph)
-			continue;
-
-		fromGlyph->KerningInfo[toCodepoint] = (entry.advance * scaleFactor) / rasterScale;
+		kerningPairs.push_back(rltKerningPair{ fromGlyphItr->second, toGlyphItr->second, (entry.advance * scaleFactor) / rasterScale });
 	}
 
-	// atlas generation
+	rltSetFontKerning(&font, kerningPairs);
 
-	Image fontAtlas = { 0 };
+	// atlas generation
 
-	std::map<int, Rectangle> glyphRects;
+	int padding = int(font.GlyphPadding);
+	int invalidSize = int(ceilf(effectivefontSize));
+	int whiteSize = 3;
 
-	// Calculate image size based on total glyph width and glyph row count
-	int totalWidth = 0;
-	int maxGlyphWidth = 0;
+	// one rect per glyph, plus the invalid glyph box and a small solid white block
+	std::vector<stbrp_rect> packRects;
+	float glyphArea = 0;
 
-	for (auto& codepoint : *setTouse)
+	for (auto& raster : rasters)
 	{
-		if (glyphImages.find(codepoint) == glyphImages.end())
-			continue;
+		stbrp_rect rect = { 0 };
+		rect.id = int(packRects.size());
+		rect.w = raster.Width + 2 * padding;
+		rect.h = raster.Height + 2 * padding;
+		packRects.push_back(rect);
 
-		if (glyphImages[codepoint].width > maxGlyphWidth)
-			maxGlyphWidth = glyphImages[codepoint].width;
-
-		totalWidth += glyphImages[codepoint].width + int(2 * font.GlyphPadding);
+		glyphArea += float(raster.Width * raster.Height);
 	}
 
-	int paddedFontSize = int(effectivefontSize + 2 * font.GlyphPadding);
-	// No need for a so-conservative atlas generation
-	float totalArea = totalWidth * paddedFontSize * 1.2f;
-	float imageMinSize = sqrtf(totalArea);
-	int imageSize = (int)powf(2, ceilf(logf(imageMinSize) / logf(2)));
+	int invalidRectIndex = int(packRects.size());
+	packRects.push_back(stbrp_rect{ invalidRectIndex, invalidSize + 2 * padding, invalidSize + 2 * padding });
 
-	if (totalArea < ((imageSize * imageSize) / 2))
-	{
-		fontAtlas.width = imageSize;    // Atlas bitmap width
-		fontAtlas.height = imageSize / 2; // Atlas bitmap height
-	}
-	else
+	int whiteRectIndex = int(packRects.size());
+	packRects.push_back(stbrp_rect{ whiteRectIndex, whiteSize + 2 * padding, whiteSize + 2 * padding });
+
+	Vector2 atlasSize = PackAtlas(packRects, loadOptions);
+	if (atlasSize.x <= 0)
 	{
-		fontAtlas.width = imageSize;   // Atlas bitmap width
-		fontAtlas.height = imageSize;  // Atlas bitmap height
+		font.Ranges.clear();
+		font.Kerning = rltKerningTable();
+		return font;
 	}
 
-	fontAtlas.data = (unsigned char*)MemAlloc(fontAtlas.width * fontAtlas.height * 2);   // Create a bitmap to store characters (8 bpp)
-	fontAtlas.format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA;
+	Image fontAtlas = { 0 };
+	fontAtlas.width = int(atlasSize.x);
+	fontAtlas.height = int(atlasSize.y);
+	fontAtlas.format = loadOptions.SingleChannel ? PIXELFORMAT_UNCOMPRESSED_GRAYSCALE : PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA;
 	fontAtlas.mipmaps = 1;
 
-	//fill it with white
-	memset(fontAtlas.data, 0, fontAtlas.width * fontAtlas.height * 2);
+	int atlasDataSize = GetPixelDataSize(fontAtlas.width, fontAtlas.height, fontAtlas.format);
+	fontAtlas.data = (unsigned char*)MemAlloc(atlasDataSize);
+
+	// clear to transparent
+	memset(fontAtlas.data, 0, atlasDataSize);
 
-	int offsetX = int(font.GlyphPadding);
-	int offsetY = int(font.GlyphPadding);
+	font.AtlasFillRatio = glyphArea / float(fontAtlas.width * fontAtlas.height);
 
-	// NOTE: Using simple packaging, one char after another
+	int glyphIndex = 0;
 	for (auto& range : font.Ranges)
 	{
 		for (auto& glyphInfo : range.Glyphs)
 		{
-			auto& image = glyphImages[glyphInfo.Value];
+			GlyphRaster& raster = rasters[glyphIndex];
+			const stbrp_rect& packed = packRects[glyphIndex++];
 
-			// Check remaining space for font.GlyphPadding
-			if (offsetX >= (fontAtlas.width - image.width - 2 * font.GlyphPadding))
-			{
-				offsetX = int(font.GlyphPadding);
-
-				// NOTE: Be careful on offsetY for SDF fonts, by default SDF
-				// use an internal padding of 4 pixels, it means char rectangle
-				// height is bigger than fontSize, it could be up to (fontSize + 8)
-				offsetY += int(effectivefontSize + 2 * font.GlyphPadding);
-			}
+			raster.AtlasX = packed.x + padding;
+			raster.AtlasY = packed.y + padding;
 
-			glyphInfo.SourceRect = { float(offsetX), float(offsetY), float(image.width), float(image.height) };
+			glyphInfo.SourceRect = { float(raster.AtlasX), float(raster.AtlasY), float(raster.Width), float(raster.Height) };
 
 			if (glyphInfo.SourceRect.y + glyphInfo.SourceRect.height > font.LowestSourceRect)
 				font.LowestSourceRect = glyphInfo.SourceRect.y + glyphInfo.SourceRect.height;
+		}
+	}
 
-			font.LastSourceRectX = glyphInfo.SourceRect.x + glyphInfo.SourceRect.width;
-
-			// copy the image to just the alpha
-			for (size_t y = 0; y < image.height; y++)
-			{
-				for (size_t x = 0; x < image.width; x++)
-				{
-					size_t sourceIndex = y * image.width + x;
-					size_t destIndex = (offsetY + y) * fontAtlas.width + (offsetX + x);
-
-					unsigned char* sourcePixel = ((unsigned char*)image.data) + sourceIndex;
-					unsigned char* destPixel = ((unsigned char*)fontAtlas.data) + (destIndex * 2);
-
-					// set the color channel to full white if the alpha is not 0, this way the alpha has a full color to blend with, not grays
-					if (*sourcePixel > 0)
-						*destPixel = 255;
-					else
-						*destPixel = 0;
+	RasterizeGlyphs(fontInfo, scaleFactor, font.SDF, rasters, fontAtlas, loadOptions.WorkerThreads);
 
-					// set the alpha based on the glyph
-					destPixel++;
-					*destPixel = *sourcePixel;
-				}
-			}
+	const stbrp_rect& whitePacked = packRects[whiteRectIndex];
+	ImageDrawRectangle(&fontAtlas, whitePacked.x + padding, whitePacked.y + padding, whiteSize, whiteSize, WHITE);
 
-			UnloadImage(image);
-			image.data = nullptr;
+	const stbrp_rect& invalidPacked = packRects[invalidRectIndex];
+	Rectangle invalidRect = { float(invalidPacked.x + padding), float(invalidPacked.y + padding), effectivefontSize, effectivefontSize };
 
-			// Move atlas position X for next character drawing
-			offsetX += int(glyphInfo.SourceRect.width + (2 * font.GlyphPadding));
-		}
+	for (const auto& packed : packRects)
+	{
+		if (packed.y + packed.h > font.LowestSourceRect)
+			font.LowestSourceRect = float(packed.y + packed.h);
 	}
 
-	int rectSize = 3;
-	ImageDrawRectangle(&fontAtlas, fontAtlas.width - rectSize, fontAtlas.height - rectSize, rectSize, rectSize, WHITE);
-
-	Rectangle invalidRect = { fontAtlas.width - rectSize - effectivefontSize - font.GlyphPadding, fontAtlas.height - effectivefontSize - font.GlyphPadding , effectivefontSize, effectivefontSize };
-
 	ImageDrawRectangleLines(&fontAtlas, invalidRect, 2, WHITE);
 
 	float width = float(MeasureText("?", int(effectivefontSize)));
@@ -503,8 +871,12 @@ rltFont rltLoadFontTTFMemory(const void* data, size_t dataSize, float fontSize,
 	font.InvalidGlyph.DestSize.y = invalidRect.height / rasterScale;
 
 	font.Texture = LoadTextureFromImage(fontAtlas);
+	if (font.SDF)
+		SetTextureFilter(font.Texture, TEXTURE_FILTER_BILINEAR);
 
-	UnloadImage(fontAtlas);
+	font.Atlas = fontAtlas;
+
+	rltRebuildGlyphLookup(&font);
 
 	return font;
 }
@@ -514,63 +886,410 @@ void rltUnloadFont(rltFont* font)
 	if (font == &DefaultFont)
 		return;
 
-	UnloadTexture(font->Texture);
+	// shared pages are unloaded with rltUnloadAtlasPages
+	if (!font->SharedTexture)
+		UnloadTexture(font->Texture);
+	font->Texture = Texture2D{ 0 };
+	font->AtlasOffset = Vector2Zeros;
+	font->SharedTexture = false;
+
+	if (font->Atlas.data)
+		UnloadImage(font->Atlas);
+	font->Atlas = Image{ 0 };
+	font->AtlasDirtyRect = Rectangle{ 0,0,0,0 };
+	font->Skyline.clear();
+	font->GlyphCache.reset();
 
 	font->Ranges.clear();
+	font->GlyphLookup.clear();
+	font->Kerning = rltKerningTable();
 }
 
-const rltGlyphInfo* rtlGetFontGlyph(const rltFont* font, int id)
+void rltRebuildGlyphLookup(rltFont* font)
 {
-	for (auto& range : font->Ranges)
+	font->GlyphLookup.assign(rltGlyphLookupSize, rltGlyphIndex());
+
+	for (int rangeIndex = 0; rangeIndex < int(font->Ranges.size()); rangeIndex++)
 	{
-		if (id < range.Start || id >(range.Start + range.Glyphs.size()))
-			continue;
+		const auto& range = font->Ranges[rangeIndex];
+		for (int glyph = 0; glyph < int(range.Glyphs.size()); glyph++)
+		{
+			size_t codepoint = range.Start + glyph;
+			if (codepoint >= rltGlyphLookupSize)
+				break;
 
-		return &range.Glyphs[id - range.Start];
+			font->GlyphLookup[codepoint] = rltGlyphIndex{ rangeIndex, glyph };
+		}
 	}
+}
 
-	return &font->InvalidGlyph;
+static bool CodepointBeforeRange(int codepoint, const rltGlyphRange& range)
+{
+	return size_t(codepoint) < range.Start;
 }
 
-const rltGlyphInfo* GetGlyphForCodePoint(const char* data, size_t& index, Vector2& currentPos, const rltFont* font, float scale)
+static bool KerningPairLess(const rltKerningPair& a, const rltKerningPair& b)
 {
-	int codepointByteCount = 0;
-	int codepoint = GetCodepointNext(data + index, &codepointByteCount);
-	index += codepointByteCount;
+	return a.Left < b.Left || (a.Left == b.Left && a.Right < b.Right);
+}
 
-	if (codepoint < 32)
-	{
-		// control character
-		if (codepoint == 10)
-		{
-			currentPos.x = 0;
-			currentPos.y += font->DefaultNewlineOffset * scale;
-		}
+static bool IsKerningAscii(int codepoint)
+{
+	return codepoint >= rltKerningAsciiStart && codepoint < rltKerningAsciiStart + rltKerningAsciiCount;
+}
+
+void rltSetFontKerning(rltFont* font, std::vector<rltKerningPair>& pairs)
+{
+	rltKerningTable& kerning = font->Kerning;
+	kerning = rltKerningTable();
+
+	std::stable_sort(pairs.begin(), pairs.end(), KerningPairLess);
+
+	bool hasAscii = false;
+	for (auto& pair : pairs)
+	{
+		if (!kerning.Pairs.empty() && !KerningPairLess(kerning.Pairs.back(), pair))
+			kerning.Pairs.back() = pair;
+		else
+			kerning.Pairs.push_back(pair);
+
+		hasAscii = hasAscii || (IsKerningAscii(pair.Left) && IsKerningAscii(pair.Right));
+	}
+
+	if (!hasAscii)
+		return;
+
+	kerning.AsciiPairs.resize(rltKerningAsciiCount * rltKerningAsciiCount, 0.0f);
+	for (auto& pair : kerning.Pairs)
+	{
+		if (IsKerningAscii(pair.Left) && IsKerningAscii(pair.Right))
+			kerning.AsciiPairs[(pair.Left - rltKerningAsciiStart) * rltKerningAsciiCount + (pair.Right - rltKerningAsciiStart)] = pair.Advance;
+	}
+}
+
+float rltGetKerning(const rltFont* font, int left, int right)
+{
+	const rltKerningTable& kerning = font->Kerning;
+	if (kerning.Pairs.empty())
+		return 0;
+
+	// the ASCII table holds every printable pair, including the ones that don't kern
+	if (!kerning.AsciiPairs.empty() && IsKerningAscii(left) && IsKerningAscii(right))
+		return kerning.AsciiPairs[(left - rltKerningAsciiStart) * rltKerningAsciiCount + (right - rltKerningAsciiStart)];
+
+	rltKerningPair key{ left, right, 0 };
+	auto itr = std::lower_bound(kerning.Pairs.begin(), kerning.Pairs.end(), key, KerningPairLess);
+	if (itr == kerning.Pairs.end() || itr->Left != left || itr->Right != right)
+		return 0;
+
+	return itr->Advance;
+}
+
+static Rectangle MergeRect(const Rectangle& a, const Rectangle& b)
+{
+	if (a.width <= 0 || a.height <= 0)
+		return b;
+
+	float x = std::min(a.x, b.x);
+	float y = std::min(a.y, b.y);
+	return Rectangle{ x, y, std::max(a.x + a.width, b.x + b.width) - x, std::max(a.y + a.height, b.y + b.height) - y };
+}
+
+// on demand glyphs
+
+struct rltGlyphCache
+{
+	struct Cell
+	{
+		int Codepoint = -1;
+		rltGlyphInfo Glyph;
+		uint64_t LastUse = 0;
+		uint64_t LastFrame = 0;
+	};
+
+	const rltFontFace* Face = nullptr;
+	float ScaleFactor = 1;
+	int Ascent = 0;
+	float RasterScale = 1;
+
+	int CellSize = 0;
+	int Columns = 0;
+	int Top = 0;				// atlas row the cells start on
+
+	std::vector<Cell> Cells;
+	std::unordered_map<int, int> CellLookup;
+	std::unordered_set<int> Unavailable;	// codepoints that can never be cached, so they are not tried every draw
+
+	uint64_t UseCount = 0;
+	unsigned int Generation = 0;
+	rltGlyphCacheStats Stats;
+
+	std::vector<unsigned char> Scratch;
+};
+
+static uint64_t GlyphCacheFrame = 1;
+
+void rltNextGlyphCacheFrame()
+{
+	GlyphCacheFrame++;
+}
+
+const rltGlyphCacheStats* rltGetGlyphCacheStats(const rltFont* font)
+{
+	if (!font || !font->GlyphCache)
 		return nullptr;
+
+	return &font->GlyphCache->Stats;
+}
+
+unsigned int rltGetGlyphCacheGeneration(const rltFont* font)
+{
+	if (!font || !font->GlyphCache)
+		return 0;
+
+	return font->GlyphCache->Generation;
+}
+
+bool rltEnableGlyphCache(rltFont* font, const rltFontFace* face, size_t budgetBytes)
+{
+	// growing the atlas reloads the texture, which a shared page can't do
+	if (!font || !face || font->Texture.id == 0 || font->GlyphCache || font->SharedTexture)
+		return false;
+
+	if (!font->Atlas.data)
+	{
+		font->Atlas = LoadImageFromTexture(font->Texture);
+		if (!font->Atlas.data)
+			return false;
+	}
+
+	auto cache = std::make_shared<rltGlyphCache>();
+	cache->Face = face;
+	cache->RasterScale = rltGetRasterScale();
+	cache->ScaleFactor = stbtt_ScaleForPixelHeight(&face->Info, font->BaseSize * cache->RasterScale);
+
+	int ascent = 0, descent = 0, lineGap = 0;
+	stbtt_GetFontVMetrics(&face->Info, &ascent, &descent, &lineGap);
+	cache->Ascent = ascent;
+
+	// square cells a full line high, wide enough for CJK and most emoji
+	int padding = int(font->GlyphPadding);
+	cache->CellSize = int(ceilf((ascent - descent) * cache->ScaleFactor)) + padding * 2;
+	if (font->SDF)
+		cache->CellSize += SDFPadding * 2;
+
+	size_t bytesPerCell = size_t(GetPixelDataSize(cache->CellSize, cache->CellSize, font->Atlas.format));
+	size_t cellCount = std::max<size_t>(1, budgetBytes / std::max<size_t>(1, bytesPerCell));
+
+	int width = std::max(font->Atlas.width, cache->CellSize);
+	cache->Columns = width / cache->CellSize;
+	int rows = int((cellCount + cache->Columns - 1) / cache->Columns);
+
+	cache->Top = font->Atlas.height;
+	cache->Cells.resize(size_t(rows) * cache->Columns);
+	cache->Stats.Cells = cache->Cells.size();
+
+	ImageResizeCanvas(&font->Atlas, width, cache->Top + rows * cache->CellSize, 0, 0, BLANK);
+
+	UnloadTexture(font->Texture);
+	font->Texture = LoadTextureFromImage(font->Atlas);
+	if (font->SDF)
+		SetTextureFilter(font->Texture, TEXTURE_FILTER_BILINEAR);
+
+	font->AtlasDirtyRect = Rectangle{ 0,0,0,0 };
+
+	// the cells take everything below the packed glyphs
+	font->LowestSourceRect = float(font->Atlas.height);
+	font->Skyline.clear();
+
+	font->GlyphCache = cache;
+	return true;
+}
+
+static int FindFreeCell(const rltGlyphCache& cache)
+{
+	int best = -1;
+	for (int i = 0; i < int(cache.Cells.size()); i++)
+	{
+		const auto& cell = cache.Cells[i];
+		if (cell.Codepoint < 0)
+			return i;
+
+		// quads drawn this frame may still be waiting in a draw list
+		if (cell.LastFrame == GlyphCacheFrame)
+			continue;
+
+		if (best < 0 || cell.LastUse < cache.Cells[best].LastUse)
+			best = i;
 	}
 
-	return rtlGetFontGlyph(font, codepoint);
+	return best;
 }
 
-void DrawGlyph(const rltGlyphInfo* glyph, const Vector2& position, Vector2& currentPos, Color tint, const rltFont* font, float scale)
+static const rltGlyphInfo* CacheGlyph(const rltFont* font, int codepoint)
+{
+	rltGlyphCache& cache = *font->GlyphCache;
+
+	auto itr = cache.CellLookup.find(codepoint);
+	if (itr != cache.CellLookup.end())
+	{
+		auto& cell = cache.Cells[itr->second];
+		cell.LastUse = ++cache.UseCount;
+		cell.LastFrame = GlyphCacheFrame;
+		cache.Stats.Hits++;
+		return &cell.Glyph;
+	}
+
+	if (cache.Unavailable.count(codepoint) != 0)
+		return &font->InvalidGlyph;
+
+	const stbtt_fontinfo& fontInfo = cache.Face->Info;
+
+	int padding = int(font->GlyphPadding);
+
+	rltGlyphInfo glyph;
+	GlyphRaster raster;
+	bool inFace = stbtt_FindGlyphIndex(&fontInfo, codepoint) > 0;
+	if (inFace)
+		MeasureGlyph(fontInfo, codepoint, cache.ScaleFactor, cache.Ascent, cache.RasterScale, font->BaseSize * cache.RasterScale, font->SDF, glyph, raster);
+
+	if (!inFace || raster.Width + padding * 2 > cache.CellSize || raster.Height + padding * 2 > cache.CellSize)
+	{
+		cache.Unavailable.insert(codepoint);
+		cache.Stats.Failures++;
+		return &font->InvalidGlyph;
+	}
+
+	int cellIndex = FindFreeCell(cache);
+	if (cellIndex < 0)
+	{
+		cache.Stats.Failures++;
+		return &font->InvalidGlyph;
+	}
+
+	auto& cell = cache.Cells[cellIndex];
+	if (cell.Codepoint >= 0)
+	{
+		cache.CellLookup.erase(cell.Codepoint);
+		cache.Stats.Evictions++;
+		cache.Generation++;
+	}
+
+	cache.Stats.Misses++;
+
+	int cellX = (cellIndex % cache.Columns) * cache.CellSize;
+	int cellY = cache.Top + (cellIndex / cache.Columns) * cache.CellSize;
+
+	ImageDrawRectangle(&font->Atlas, cellX, cellY, cache.CellSize, cache.CellSize, BLANK);
+
+	raster.AtlasX = cellX + padding;
+	raster.AtlasY = cellY + padding;
+	RasterizeGlyphRange(fontInfo, cache.ScaleFactor, font->SDF, &raster, 1, font->Atlas, cache.Scratch);
+
+	glyph.SourceRect = Rectangle{ float(raster.AtlasX), float(raster.AtlasY), float(raster.Width), float(raster.Height) };
+
+	cell.Codepoint = codepoint;
+	cell.Glyph = glyph;
+	cell.LastUse = ++cache.UseCount;
+	cell.LastFrame = GlyphCacheFrame;
+	cache.CellLookup[codepoint] = cellIndex;
+
+	// goes up with the next texture update, after the text that needed it is laid out
+	font->AtlasDirtyRect = MergeRect(font->AtlasDirtyRect, Rectangle{ float(cellX), float(cellY), float(cache.CellSize), float(cache.CellSize) });
+
+	return &cell.Glyph;
+}
+
+const rltGlyphInfo* rtlGetFontGlyph(const rltFont* font, int id)
 {
-	if (glyph)
+	if (id < 0)
+		return &font->InvalidGlyph;
+
+	if (id < int(font->GlyphLookup.size()))
 	{
-		float offsetY = position.y + currentPos.y + (glyph->Offset.y * scale);
+		const rltGlyphIndex& index = font->GlyphLookup[id];
+		if (index.Range < 0)
+			return &font->InvalidGlyph;
+
+		return &font->Ranges[index.Range].Glyphs[index.Glyph];
+	}
+
+	// find the last range that starts at or before the codepoint
+	auto itr = std::upper_bound(font->Ranges.begin(), font->Ranges.end(), id, CodepointBeforeRange);
+	if (itr == font->Ranges.begin())
+		return &font->InvalidGlyph;
+
+	--itr;
+	if (size_t(id) >= itr->Start + itr->Glyphs.size())
+		return &font->InvalidGlyph;
 
-		Rectangle srcRect = glyph->SourceRect;
-		if (TextIsYFlipped)
+	return &itr->Glyphs[id - itr->Start];
+}
+
+static const rltGlyphInfo* GetGlyphForCodePoint(int codepoint, Vector2& currentPos, const rltFont* font, float scale)
+{
+	if (codepoint < 32)
+	{
+		// control character
+		if (codepoint == 10)
 		{
-			srcRect.height *= -1;
-			offsetY = position.y + currentPos.y; // TODO, should the offset be computed here?
+			currentPos.x = 0;
+			currentPos.y += font->DefaultNewlineOffset * scale;
 		}
-		Rectangle destRect = { position.x + currentPos.x + (glyph->Offset.x * scale), offsetY , glyph->DestSize.x * scale , glyph->DestSize.y * scale };
+		return nullptr;
+	}
+
+	const rltGlyphInfo* glyph = rtlGetFontGlyph(font, codepoint);
+	if (glyph == &font->InvalidGlyph && font->GlyphCache)
+		return CacheGlyph(font, codepoint);
+
+	return glyph;
+}
+
+const rltGlyphInfo* GetGlyphForCodePoint(const char* data, size_t& index, Vector2& currentPos, const rltFont* font, float scale)
+{
+	int codepointByteCount = 0;
+	int codepoint = GetCodepointNext(data + index, &codepointByteCount);
+	index += codepointByteCount;
+
+	return GetGlyphForCodePoint(codepoint, currentPos, font, scale);
+}
+
+static bool PlaceGlyph(const rltGlyphInfo* glyph, const Vector2& position, Vector2& currentPos, const rltFont* font, float scale, Rectangle& srcRect, Rectangle& destRect)
+{
+	if (!glyph)
+		return false;
 
-		DrawTexturePro(font->Texture, srcRect, destRect, Vector2Zeros, 0, tint);
-		currentPos.x += destRect.width;
+	float offsetY = position.y + currentPos.y + (glyph->Offset.y * scale);
 
-		currentPos.x += font->DefaultSpacing * scale;
+	srcRect = glyph->SourceRect;
+	srcRect.x += font->AtlasOffset.x;
+	srcRect.y += font->AtlasOffset.y;
+	if (TextIsYFlipped)
+	{
+		srcRect.height *= -1;
+		offsetY = position.y + currentPos.y; // TODO, should the offset be computed here?
 	}
+	destRect = { position.x + currentPos.x + (glyph->Offset.x * scale), offsetY , glyph->DestSize.x * scale , glyph->DestSize.y * scale };
+
+	currentPos.x += destRect.width;
+	currentPos.x += font->DefaultSpacing * scale;
+	return true;
+}
+
+static void DrawGlyphQuad(const Texture2D& texture, const Rectangle& srcRect, const Rectangle& destRect, Color tint, bool sdf)
+{
+	if (GlyphDrawFunction)
+		GlyphDrawFunction(texture, srcRect, destRect, tint, rltGetFontShader(texture, sdf));
+	else
+		DrawTexturePro(texture, srcRect, destRect, Vector2Zeros, 0, tint);
+}
+
+void DrawGlyph(const rltGlyphInfo* glyph, const Vector2& position, Vector2& currentPos, Color tint, const rltFont* font, float scale)
+{
+	Rectangle srcRect, destRect;
+	if (PlaceGlyph(glyph, position, currentPos, font, scale, srcRect, destRect))
+		DrawGlyphQuad(font->Texture, srcRect, destRect, tint, font->SDF);
 }
 
 int getDigit(const char input)
@@ -608,7 +1327,7 @@ unsigned char GetHexValue(const char* ptr, size_t& offset)
 	return getDigit(ptr[offset++]) * 16 + getDigit(ptr[offset++]);
 }
 
-Color ProcessColorSequence(std::string_view text, size_t& index, Color currentColor)
+Color ProcessColorSequence(std::string_view text, size_t& index, Color currentColor, bool* colorSet = nullptr)
 {
 	if (text.data()[index] == '\a')
 	{
@@ -626,6 +1345,9 @@ Color ProcessColorSequence(std::string_view text, size_t& index, Color currentCo
 					currentColor.g = GetHexValue(text.data(), index);
 					currentColor.b = GetHexValue(text.data(), index);
 					currentColor.a = GetHexValue(text.data(), index);
+
+					if (colorSet)
+						*colorSet = true;
 				}
 			}
 		}
@@ -640,6 +1362,8 @@ void rltDrawText(std::string_view text, float size, const Vector2& position, Col
 	if (font)
 		fontToUse = font;
 
+	rltUpdateFontTexture(fontToUse);
+
 	Vector2 currentPos{ 0,0 };
 
 	float scale = size / fontToUse->BaseSize;
@@ -648,25 +1372,25 @@ void rltDrawText(std::string_view text, float size, const Vector2& position, Col
 
 	const rltGlyphInfo* lastGlyph = nullptr;
 
+	bool shaded = BeginFontShader(fontToUse->Texture, fontToUse->SDF);
+
 	for (size_t i = 0; i < text.size();)
 	{
 		tintToUse = ProcessColorSequence(text, i, tintToUse);
 		const rltGlyphInfo* glyph = GetGlyphForCodePoint(text.data(), i, currentPos, fontToUse, scale);
 
-		if (lastGlyph && glyph && !lastGlyph->KerningInfo.empty())
-		{
-			auto itr = lastGlyph->KerningInfo.find(glyph->Value);
-			if (itr != lastGlyph->KerningInfo.end())
-			{
-				if (currentPos.x > 0)
-					currentPos.x += itr->second * scale;
-			}
-		}
+		if (lastGlyph && glyph && currentPos.x > 0)
+			currentPos.x += rltGetKerning(fontToUse, lastGlyph->Value, glyph->Value) * scale;
 
 		DrawGlyph(glyph, position, currentPos, tintToUse, fontToUse, scale);
 
 		lastGlyph = glyph;
 	}
+
+	// glyphs cached while drawing, the quads are still batched so this lands before they reach the GPU
+	rltUpdateFontTexture(fontToUse);
+
+	EndFontShader(shaded);
 }
 
 void rltDrawTextJustified(std::string_view text, float size, const Vector2& position, Color tint, rltAllignment allignment, const rltFont* font)
@@ -699,6 +1423,8 @@ float rltDrawTextWrapped(std::string_view text, float size, const Vector2& posit
 	if (font)
 		fontToUse = font;
 
+	rltUpdateFontTexture(fontToUse);
+
 	Vector2 currentPos = Vector2Zeros;
 
 	float scale = size / fontToUse->BaseSize;
@@ -706,6 +1432,8 @@ float rltDrawTextWrapped(std::string_view text, float size, const Vector2& posit
 	const rltGlyphInfo* lastGlyph = nullptr;
 
 	Color tintToUse = tint;
+	bool shaded = BeginFontShader(fontToUse->Texture, fontToUse->SDF);
+
 	for (size_t i = 0; i < text.size();)
 	{
 		tintToUse = ProcessColorSequence(text, i, tintToUse);
@@ -722,21 +1450,19 @@ float rltDrawTextWrapped(std::string_view text, float size, const Vector2& posit
 			currentPos.y += fontToUse->DefaultNewlineOffset * scale;
 		}
 
-		if (lastGlyph && glyph && !lastGlyph->KerningInfo.empty())
-		{
-			auto itr = lastGlyph->KerningInfo.find(glyph->Value);
-			if (itr != lastGlyph->KerningInfo.end())
-			{
-				if (currentPos.x > 0)
-					currentPos.x += itr->second * scale;
-			}
-		}
+		if (lastGlyph && glyph && currentPos.x > 0)
+			currentPos.x += rltGetKerning(fontToUse, lastGlyph->Value, glyph->Value) * scale;
 
 		DrawGlyph(glyph, position, currentPos, tintToUse, fontToUse, scale);
 
 		lastGlyph = glyph;
 	}
 
+	// glyphs cached while drawing, the quads are still batched so this lands before they reach the GPU
+	rltUpdateFontTexture(fontToUse);
+
+	EndFontShader(shaded);
+
 	return currentPos.y + fontToUse->DefaultNewlineOffset * scale;
 }
 
@@ -760,143 +1486,1185 @@ Vector2 rltMeasureText(std::string_view text, float size, const rltFont* font)
 		if (glyph)
 		{
 			currentPos.x += glyph->DestSize.x * scale;
-			currentPos.x += font->DefaultSpacing * scale;
+			currentPos.x += fontToUse->DefaultSpacing * scale;
 		}
 
 		if (currentPos.x > maxWidth)
 			maxWidth = currentPos.x;
 	}
 
-	currentPos.y += font->DefaultNewlineOffset * scale;
+	currentPos.y += fontToUse->DefaultNewlineOffset * scale;
 	currentPos.x = maxWidth;
 	return currentPos;
 }
 
-bool rltFontHasCodepoint(rltFont* font, int codepoint)
-{
-	if (!font)
-		return false;
+// prefix advances
 
-	auto* glyph = rtlGetFontGlyph(font, codepoint);
+// how far PlaceGlyph moves the pen for a glyph
+static float GlyphAdvance(const rltGlyphInfo* glyph, const rltFont* font, float scale)
+{
+	if (!glyph)
+		return 0;
 
-	return glyph != &font->InvalidGlyph;
+	return (glyph->DestSize.x + font->DefaultSpacing) * scale;
 }
 
-bool rltFontHasAllGlyphsInString(rltFont* font, std::string_view text)
+void rltBuildTextAdvances(rltTextAdvances& advances, std::string_view text, float size, const rltFont* font)
 {
-	if (!font)
-		return false;
+	const rltFont* fontToUse = &rltGetDefaultFont();
+	if (font)
+		fontToUse = font;
 
-	Vector2 currentPos = Vector2Zeros;
+	float scale = size / fontToUse->BaseSize;
+
+	advances.Offsets.clear();
+	advances.Advances.clear();
+	advances.Lines.clear();
+	advances.Lines.push_back(0);
+	advances.LineHeight = fontToUse->DefaultNewlineOffset * scale;
+	advances.Size = Vector2Zeros;
+
+	float lineWidth = 0;
+	const rltGlyphInfo* lastGlyph = nullptr;
+	Vector2 unusedPos = Vector2Zeros;
 
 	for (size_t i = 0; i < text.size();)
 	{
+		size_t stop = i;
+
 		ProcessColorSequence(text, i, WHITE);
-		const auto* glyph = GetGlyphForCodePoint(text.data(), i, currentPos, font, 1);
+		if (i >= text.size())
+			break;
 
-		if (glyph != &font->InvalidGlyph)
-			return false;
+		int codepointByteCount = 0;
+		int codepoint = GetCodepointNext(text.data() + i, &codepointByteCount);
+
+		if (codepoint == '\n')
+		{
+			advances.Offsets.push_back(stop);
+			advances.Advances.push_back(lineWidth);
+			advances.Size.x = std::max(advances.Size.x, lineWidth);
+
+			i += codepointByteCount;
+			advances.Lines.push_back(advances.Offsets.size());
+			lineWidth = 0;
+			lastGlyph = nullptr;
+			continue;
+		}
+
+		// other control characters take no room
+		const rltGlyphInfo* glyph = GetGlyphForCodePoint(text.data(), i, unusedPos, fontToUse, scale);
+		if (!glyph)
+		{
+			lastGlyph = nullptr;
+			continue;
+		}
+
+		// kerning moves the glyph itself, so the caret in front of it sits after the kerning like in the draw path
+		if (lastGlyph && lineWidth > 0)
+			lineWidth += rltGetKerning(fontToUse, lastGlyph->Value, glyph->Value) * scale;
+
+		advances.Offsets.push_back(stop);
+		advances.Advances.push_back(lineWidth);
+
+		lineWidth += GlyphAdvance(glyph, fontToUse, scale);
+		lastGlyph = glyph;
 	}
-	return true;
+
+	advances.Offsets.push_back(text.size());
+	advances.Advances.push_back(lineWidth);
+	advances.Size.x = std::max(advances.Size.x, lineWidth);
+	advances.Size.y = advances.Lines.size() * advances.LineHeight;
 }
 
-bool GlyphLocationIsValid(rltFont* font, Rectangle& rectangle)
+static size_t LineOfStop(const rltTextAdvances& advances, size_t stop)
 {
-	float right = rectangle.x + rectangle.width + font->GlyphPadding;
-	float bottom = rectangle.y + rectangle.height + font->GlyphPadding;
+	return size_t(std::upper_bound(advances.Lines.begin(), advances.Lines.end(), stop) - advances.Lines.begin()) - 1;
+}
 
-	float cornerY = font->InvalidGlyph.SourceRect.y - font->GlyphPadding;
-	float cornerX = font->InvalidGlyph.SourceRect.x - font->GlyphPadding;
+static size_t LastStopOfLine(const rltTextAdvances& advances, size_t line)
+{
+	if (line + 1 < advances.Lines.size())
+		return advances.Lines[line + 1] - 1;
 
-	// we have plenty of space
-	if (right <= font->Texture.width && bottom < cornerY)
-		return true;
+	return advances.Offsets.size() - 1;
+}
 
-	// we are over the right side
-	if (right > font->Texture.width)
-	{
-		// move down to the left
-		rectangle.y = font->LowestSourceRect + font->GlyphPadding;
-		rectangle.x = font->GlyphPadding;
+// the first stop at or after a byte offset, offsets inside a glyph or escape move forward to the next stop
+static size_t StopAtOffset(const rltTextAdvances& advances, size_t offset)
+{
+	size_t stop = size_t(std::lower_bound(advances.Offsets.begin(), advances.Offsets.end(), offset) - advances.Offsets.begin());
+	return std::min(stop, advances.Offsets.size() - 1);
+}
 
-		// we are out of room
-		if (rectangle.y + rectangle.height > font->Texture.height)
-			return false;
+size_t rltGetTextOffsetAt(const rltTextAdvances& advances, const Vector2& point)
+{
+	if (advances.Offsets.empty())
+		return 0;
 
-		// it's too big to even fit
-		if (rectangle.x + rectangle.width + font->GlyphPadding > font->Texture.width)
-			return false;
+	size_t line = 0;
+	if (advances.LineHeight > 0 && point.y > 0)
+		line = std::min(size_t(point.y / advances.LineHeight), advances.Lines.size() - 1);
 
-		// it can fit
-		return true;
-	}
+	auto first = advances.Advances.begin() + advances.Lines[line];
+	auto last = advances.Advances.begin() + LastStopOfLine(advances, line) + 1;
 
-	return true;
+	auto itr = std::upper_bound(first, last, point.x);
+	if (itr == first)
+		return advances.Offsets[advances.Lines[line]];
+
+	// the point is between the stop before it and the one after, take whichever is closer
+	if (itr == last || point.x - *(itr - 1) <= *itr - point.x)
+		--itr;
+
+	return advances.Offsets[itr - advances.Advances.begin()];
 }
 
-bool rltAddGlpyhToFont(rltFont* font, int codepoint, Image& glpyhImage, const Vector2& offeset, float advance)
+Vector2 rltGetCaretPosition(const rltTextAdvances& advances, size_t offset)
 {
-	if (!font)
-		return false;
+	if (advances.Offsets.empty())
+		return Vector2Zeros;
 
-	auto& lastRect = font->Ranges.back().Glyphs.back().SourceRect;
+	size_t stop = StopAtOffset(advances, offset);
+	return Vector2{ advances.Advances[stop], LineOfStop(advances, stop) * advances.LineHeight };
+}
 
-	Rectangle nextSourceRect = { font->LastSourceRectX + lastRect.width + font->GlyphPadding , lastRect.y, float(glpyhImage.width), float(glpyhImage.height) };
+void rltGetSelectionRects(const rltTextAdvances& advances, size_t start, size_t end, std::vector<Rectangle>& rects)
+{
+	rects.clear();
+	if (advances.Offsets.empty())
+		return;
 
-	if (!GlyphLocationIsValid(font, nextSourceRect))
-		return false;
+	if (end < start)
+		std::swap(start, end);
 
-	Image bitmap = LoadImageFromTexture(font->Texture);
+	size_t startStop = StopAtOffset(advances, start);
+	size_t endStop = StopAtOffset(advances, end);
 
-	rltGlyphInfo newGlyph;
+	size_t startLine = LineOfStop(advances, startStop);
+	size_t endLine = LineOfStop(advances, endStop);
 
-	newGlyph.Value = codepoint;
-	newGlyph.SourceRect = nextSourceRect;
-	newGlyph.DestSize.x = newGlyph.SourceRect.width;
-	newGlyph.DestSize.y = newGlyph.SourceRect.height;
+	for (size_t line = startLine; line <= endLine; line++)
+	{
+		float left = line == startLine ? advances.Advances[startStop] : 0;
+		float right = line == endLine ? advances.Advances[endStop] : advances.Advances[LastStopOfLine(advances, line)];
 
-	if (nextSourceRect.y + nextSourceRect.height > font->LowestSourceRect)
-		font->LowestSourceRect = nextSourceRect.y + nextSourceRect.height;
+		rects.push_back(Rectangle{ left, line * advances.LineHeight, right - left, advances.LineHeight });
+	}
+}
 
-	font->LastSourceRectX = nextSourceRect.x + nextSourceRect.width;
+size_t rltFitTextWidth(const rltTextAdvances& advances, size_t line, float width)
+{
+	if (line >= advances.Lines.size() || advances.Offsets.empty())
+		return 0;
 
-	newGlyph.Offset = offeset;
-	newGlyph.NextCharacterAdvance = advance;
-	if (newGlyph.NextCharacterAdvance < 0)
-		newGlyph.NextCharacterAdvance = font->DefaultSpacing;
+	auto first = advances.Advances.begin() + advances.Lines[line];
+	auto last = advances.Advances.begin() + LastStopOfLine(advances, line) + 1;
 
-	ImageDraw(&bitmap,
-		glpyhImage,
-		Rectangle{ 0,0, float(glpyhImage.width), float(glpyhImage.height) },
-		newGlyph.SourceRect,
-		WHITE);
+	// the first stop is the empty prefix, which always fits
+	auto itr = std::upper_bound(first + 1, last, width);
+	return advances.Offsets[(itr - 1) - advances.Advances.begin()];
+}
 
-	UpdateTexture(font->Texture, bitmap.data);
-	UnloadImage(bitmap);
+bool rltTruncateText(std::string& truncated, std::string_view text, const rltTextAdvances& advances, float width, float size, const rltFont* font, std::string_view ellipsis)
+{
+	truncated.clear();
+	if (advances.Offsets.empty())
+		return false;
 
-	for (auto itr = font->Ranges.begin(); itr != font->Ranges.end(); itr++)
+	float ellipsisWidth = rltMeasureText(ellipsis, size, font).x;
+	bool cut = false;
+
+	for (size_t line = 0; line < advances.Lines.size(); line++)
 	{
-		if (codepoint < itr->Start)
-		{
-			// we have to insert a new item before this one
-			rltGlyphRange range;
-			range.Start = codepoint;
-			range.Glyphs.push_back(newGlyph);
-			font->Ranges.insert(itr, range);
-			return true;
-		}
-		else if (codepoint == itr->Start + itr->Glyphs.size())
+		size_t firstStop = advances.Lines[line];
+		size_t lastStop = LastStopOfLine(advances, line);
+
+		size_t lineStart = advances.Offsets[firstStop];
+		size_t lineEnd = line + 1 < advances.Lines.size() ? advances.Offsets[lastStop + 1] : text.size();
+
+		if (advances.Advances[lastStop] <= width)
 		{
-			itr->Glyphs.push_back(newGlyph);
-			return true;
+			// the newline comes along with the rest of the line
+			truncated.append(text.substr(lineStart, lineEnd - lineStart));
+			continue;
 		}
 
-		rltGlyphRange range;
-		range.Start = codepoint;
-		range.Glyphs.push_back(newGlyph);
-		font->Ranges.push_back(range);
-		return true;
+		cut = true;
+		truncated.append(text.substr(lineStart, rltFitTextWidth(advances, line, width - ellipsisWidth) - lineStart));
+		truncated.append(ellipsis);
+
+		if (line + 1 < advances.Lines.size())
+			truncated.push_back('\n');
 	}
 
-	return false;
-}
\ No newline at end of file
+	return cut;
+}
+
+void rltBuildTextLayout(rltTextLayout& layout, std::string_view text, float size, const rltFont* font)
+{
+	const rltFont* fontToUse = &rltGetDefaultFont();
+	if (font)
+		fontToUse = font;
+
+	rltUpdateFontTexture(fontToUse);
+
+	layout.Quads.clear();
+	layout.Texture = fontToUse->Texture;
+	layout.SDF = fontToUse->SDF;
+	layout.Size = rltMeasureText(text, size, fontToUse);
+
+	Vector2 currentPos{ 0,0 };
+
+	float scale = size / fontToUse->BaseSize;
+
+	rltTextQuad quad;
+
+	const rltGlyphInfo* lastGlyph = nullptr;
+
+	for (size_t i = 0; i < text.size();)
+	{
+		bool colorSet = false;
+		quad.Tint = ProcessColorSequence(text, i, quad.Tint, &colorSet);
+		if (colorSet)
+			quad.UseTint = false;
+
+		const rltGlyphInfo* glyph = GetGlyphForCodePoint(text.data(), i, currentPos, fontToUse, scale);
+
+		if (lastGlyph && glyph && currentPos.x > 0)
+			currentPos.x += rltGetKerning(fontToUse, lastGlyph->Value, glyph->Value) * scale;
+
+		if (PlaceGlyph(glyph, Vector2Zeros, currentPos, fontToUse, scale, quad.Source, quad.Dest))
+			layout.Quads.push_back(quad);
+
+		lastGlyph = glyph;
+	}
+
+	rltUpdateFontTexture(fontToUse);
+	layout.GlyphCacheGeneration = rltGetGlyphCacheGeneration(fontToUse);
+}
+
+void rltDrawTextLayout(const rltTextLayout& layout, const Vector2& position, Color tint)
+{
+	bool shaded = BeginFontShader(layout.Texture, layout.SDF);
+
+	for (const auto& quad : layout.Quads)
+	{
+		Rectangle destRect = { quad.Dest.x + position.x, quad.Dest.y + position.y, quad.Dest.width, quad.Dest.height };
+		DrawGlyphQuad(layout.Texture, quad.Source, destRect, quad.UseTint ? tint : quad.Tint, layout.SDF);
+	}
+
+	EndFontShader(shaded);
+}
+
+bool rltGetGlyphQuad(rltTextQuad& quad, float& advance, int codepoint, float size, const rltFont* font)
+{
+	const rltFont* fontToUse = &rltGetDefaultFont();
+	if (font)
+		fontToUse = font;
+
+	if (codepoint < 32)
+		return false;
+
+	const rltGlyphInfo* glyph = rtlGetFontGlyph(fontToUse, codepoint);
+	if (glyph == &fontToUse->InvalidGlyph && fontToUse->GlyphCache)
+		glyph = CacheGlyph(fontToUse, codepoint);
+
+	Vector2 currentPos = Vector2Zeros;
+	if (!PlaceGlyph(glyph, Vector2Zeros, currentPos, fontToUse, size / fontToUse->BaseSize, quad.Source, quad.Dest))
+		return false;
+
+	rltUpdateFontTexture(fontToUse);
+
+	advance = currentPos.x;
+	return true;
+}
+
+// compiled text
+
+static void StartSpan(rltCompiledText& compiled, const rltTextSpan& span)
+{
+	// an empty span was never drawn with, so it can just take the new settings
+	if (!compiled.Spans.empty() && compiled.Spans.back().Count == 0)
+		compiled.Spans.back() = span;
+	else
+		compiled.Spans.push_back(span);
+
+	compiled.Spans.back().Start = compiled.Codepoints.size();
+	compiled.Spans.back().Count = 0;
+}
+
+void rltCompileText(rltCompiledText& compiled, std::string_view text)
+{
+	compiled.Codepoints.clear();
+	compiled.Spans.clear();
+
+	rltAppendCompiledText(compiled, text);
+}
+
+void rltAppendCompiledText(rltCompiledText& compiled, std::string_view text, const rltFont* font, float size)
+{
+	// a colour set earlier carries on into the appended text, like it would if the strings were joined
+	rltTextSpan span;
+	if (!compiled.Spans.empty())
+	{
+		span.Tint = compiled.Spans.back().Tint;
+		span.UseTint = compiled.Spans.back().UseTint;
+	}
+	span.Font = font;
+	span.Size = size;
+	StartSpan(compiled, span);
+
+	for (size_t i = 0; i < text.size();)
+	{
+		bool colorSet = false;
+		span.Tint = ProcessColorSequence(text, i, span.Tint, &colorSet);
+		if (colorSet)
+		{
+			span.UseTint = false;
+			StartSpan(compiled, span);
+		}
+
+		if (i >= text.size())
+			break;
+
+		int codepointByteCount = 0;
+		compiled.Codepoints.push_back(GetCodepointNext(text.data() + i, &codepointByteCount));
+		compiled.Spans.back().Count++;
+		i += codepointByteCount;
+	}
+}
+
+void rltDrawCompiledText(const rltCompiledText& compiled, float size, const Vector2& position, Color tint, const rltFont* font)
+{
+	const rltFont* baseFont = &rltGetDefaultFont();
+	if (font)
+		baseFont = font;
+
+	Vector2 currentPos{ 0,0 };
+
+	const rltGlyphInfo* lastGlyph = nullptr;
+	const rltFont* lastFont = nullptr;
+
+	for (const auto& span : compiled.Spans)
+	{
+		if (span.Count == 0)
+			continue;
+
+		const rltFont* fontToUse = span.Font ? span.Font : baseFont;
+		float scale = (span.Size > 0 ? span.Size : size) / fontToUse->BaseSize;
+		Color tintToUse = span.UseTint ? tint : span.Tint;
+
+		// kerning only applies between glyphs of the same font
+		if (fontToUse != lastFont)
+			lastGlyph = nullptr;
+		lastFont = fontToUse;
+
+		rltUpdateFontTexture(fontToUse);
+		bool shaded = BeginFontShader(fontToUse->Texture, fontToUse->SDF);
+
+		for (size_t i = span.Start; i < span.Start + span.Count; i++)
+		{
+			const rltGlyphInfo* glyph = GetGlyphForCodePoint(compiled.Codepoints[i], currentPos, fontToUse, scale);
+
+			if (lastGlyph && glyph && currentPos.x > 0)
+				currentPos.x += rltGetKerning(fontToUse, lastGlyph->Value, glyph->Value) * scale;
+
+			DrawGlyph(glyph, position, currentPos, tintToUse, fontToUse, scale);
+
+			lastGlyph = glyph;
+		}
+
+		rltUpdateFontTexture(fontToUse);
+		EndFontShader(shaded);
+	}
+}
+
+Vector2 rltMeasureCompiledText(const rltCompiledText& compiled, float size, const rltFont* font)
+{
+	const rltFont* baseFont = &rltGetDefaultFont();
+	if (font)
+		baseFont = font;
+
+	Vector2 currentPos{ 0,0 };
+
+	float maxWidth = 0;
+	float lineHeight = baseFont->DefaultNewlineOffset * size / baseFont->BaseSize;
+
+	for (const auto& span : compiled.Spans)
+	{
+		const rltFont* fontToUse = span.Font ? span.Font : baseFont;
+		float scale = (span.Size > 0 ? span.Size : size) / fontToUse->BaseSize;
+
+		// the last line is as tall as the biggest text on it
+		lineHeight = std::max(lineHeight, fontToUse->DefaultNewlineOffset * scale);
+
+		for (size_t i = span.Start; i < span.Start + span.Count; i++)
+		{
+			const rltGlyphInfo* glyph = GetGlyphForCodePoint(compiled.Codepoints[i], currentPos, fontToUse, scale);
+
+			if (compiled.Codepoints[i] == '\n')
+				lineHeight = fontToUse->DefaultNewlineOffset * scale;
+
+			if (glyph)
+				currentPos.x += (glyph->DestSize.x + fontToUse->DefaultSpacing) * scale;
+
+			if (currentPos.x > maxWidth)
+				maxWidth = currentPos.x;
+		}
+	}
+
+	return Vector2{ maxWidth, currentPos.y + lineHeight };
+}
+
+bool rltFontHasAllGlyphsInCompiledText(const rltFont* font, const rltCompiledText& compiled)
+{
+	if (!font)
+		return false;
+
+	for (int codepoint : compiled.Codepoints)
+	{
+		// control characters have no glyph to miss
+		if (codepoint >= 32 && rtlGetFontGlyph(font, codepoint) == &font->InvalidGlyph)
+			return false;
+	}
+	return true;
+}
+
+// word wrapping
+
+// greedy breaking from a word onward, appending to the lines already there
+static void BreakLines(rltWrappedText& wrapped, size_t firstWord, float width)
+{
+	wrapped.Width = width;
+
+	rltTextLine line;
+	bool lineOpen = false;
+	float pendingSpace = 0;
+
+	for (size_t wordIndex = firstWord; wordIndex < wrapped.Words.size(); wordIndex++)
+	{
+		const rltTextWord& word = wrapped.Words[wordIndex];
+
+		if (lineOpen && line.Width + pendingSpace + word.Width > width)
+		{
+			line.NextWordWidth = pendingSpace + word.Width;
+			wrapped.Lines.push_back(line);
+			lineOpen = false;
+		}
+
+		if (!lineOpen)
+		{
+			line = rltTextLine();
+			line.Start = word.Start;
+			line.FirstWord = wordIndex;
+			line.Width = word.Width;
+			lineOpen = true;
+		}
+		else
+		{
+			line.Width += pendingSpace + word.Width;
+		}
+
+		line.End = word.End;
+		line.WordCount++;
+		pendingSpace = word.SpaceWidth;
+
+		if (word.BreakAfter)
+		{
+			wrapped.Lines.push_back(line);
+			lineOpen = false;
+		}
+	}
+
+	if (lineOpen)
+		wrapped.Lines.push_back(line);
+
+	wrapped.Size.x = 0;
+	for (const auto& brokenLine : wrapped.Lines)
+		wrapped.Size.x = std::max(wrapped.Size.x, brokenLine.Width);
+
+	wrapped.Size.y = wrapped.Lines.size() * wrapped.LineHeight;
+}
+
+void rltBuildWrappedText(rltWrappedText& wrapped, std::string_view text, float size, float width, const rltFont* font)
+{
+	const rltFont* fontToUse = &rltGetDefaultFont();
+	if (font)
+		fontToUse = font;
+
+	float scale = size / fontToUse->BaseSize;
+
+	wrapped.Words.clear();
+	wrapped.Lines.clear();
+	wrapped.LineHeight = fontToUse->DefaultNewlineOffset * scale;
+
+	rltTextWord word;
+	bool inSpaces = false;
+	const rltGlyphInfo* lastGlyph = nullptr;
+	Vector2 unusedPos = Vector2Zeros;
+
+	for (size_t i = 0; i < text.size();)
+	{
+		ProcessColorSequence(text, i, WHITE);
+		if (i >= text.size())
+			break;
+
+		int codepointByteCount = 0;
+		int codepoint = GetCodepointNext(text.data() + i, &codepointByteCount);
+
+		if (codepoint == '\n')
+		{
+			word.BreakAfter = true;
+			wrapped.Words.push_back(word);
+
+			i += codepointByteCount;
+			word = rltTextWord();
+			word.Start = word.End = i;
+			inSpaces = false;
+			lastGlyph = nullptr;
+			continue;
+		}
+
+		if (codepoint == ' ')
+		{
+			inSpaces = true;
+			word.SpaceWidth += GlyphAdvance(GetGlyphForCodePoint(text.data(), i, unusedPos, fontToUse, scale), fontToUse, scale);
+			lastGlyph = nullptr;
+			continue;
+		}
+
+		// the first glyph after spaces starts the next word
+		if (inSpaces)
+		{
+			wrapped.Words.push_back(word);
+			word = rltTextWord();
+			word.Start = word.End = i;
+			inSpaces = false;
+		}
+
+		const rltGlyphInfo* glyph = GetGlyphForCodePoint(text.data(), i, unusedPos, fontToUse, scale);
+
+		if (lastGlyph && glyph)
+			word.Width += rltGetKerning(fontToUse, lastGlyph->Value, glyph->Value) * scale;
+
+		word.Width += GlyphAdvance(glyph, fontToUse, scale);
+		word.End = i;
+
+		if (glyph)
+			lastGlyph = glyph;
+	}
+
+	wrapped.Words.push_back(word);
+
+	BreakLines(wrapped, 0, width);
+}
+
+void rltReflowWrappedText(rltWrappedText& wrapped, float width)
+{
+	if (width == wrapped.Width)
+		return;
+
+	// a line stays the same while it still fits and the word after it still doesn't
+	size_t keptLines = 0;
+	for (; keptLines < wrapped.Lines.size(); keptLines++)
+	{
+		const rltTextLine& line = wrapped.Lines[keptLines];
+
+		if (line.WordCount > 1 && line.Width > width)
+			break;
+
+		if (line.NextWordWidth >= 0 && line.Width + line.NextWordWidth <= width)
+			break;
+	}
+
+	if (keptLines == wrapped.Lines.size())
+	{
+		wrapped.Width = width;
+		return;
+	}
+
+	size_t firstWord = wrapped.Lines[keptLines].FirstWord;
+	wrapped.Lines.resize(keptLines);
+
+	BreakLines(wrapped, firstWord, width);
+}
+
+void rltBuildWrappedTextLayout(rltTextLayout& layout, std::string_view text, const rltWrappedText& wrapped, float size, rltAllignment allignment, const rltFont* font)
+{
+	const rltFont* fontToUse = &rltGetDefaultFont();
+	if (font)
+		fontToUse = font;
+
+	rltUpdateFontTexture(fontToUse);
+
+	layout.Quads.clear();
+	layout.Texture = fontToUse->Texture;
+	layout.SDF = fontToUse->SDF;
+	layout.Size = wrapped.Size;
+
+	float scale = size / fontToUse->BaseSize;
+
+	rltTextQuad quad;
+
+	size_t i = 0;
+	for (size_t lineIndex = 0; lineIndex < wrapped.Lines.size(); lineIndex++)
+	{
+		const rltTextLine& line = wrapped.Lines[lineIndex];
+
+		// colour escapes between the lines still apply
+		while (i < line.Start)
+		{
+			bool colorSet = false;
+			quad.Tint = ProcessColorSequence(text, i, quad.Tint, &colorSet);
+			if (colorSet)
+				quad.UseTint = false;
+
+			if (i >= line.Start)
+				break;
+
+			int codepointByteCount = 0;
+			GetCodepointNext(text.data() + i, &codepointByteCount);
+			i += codepointByteCount;
+		}
+
+		Vector2 origin = Vector2Zeros;
+		if (allignment == rltAllignment::Center)
+			origin.x = (wrapped.Size.x - line.Width) * 0.5f;
+		else if (allignment == rltAllignment::Right)
+			origin.x = wrapped.Size.x - line.Width;
+
+		Vector2 currentPos = { 0, lineIndex * wrapped.LineHeight };
+		const rltGlyphInfo* lastGlyph = nullptr;
+
+		while (i < line.End)
+		{
+			bool colorSet = false;
+			quad.Tint = ProcessColorSequence(text, i, quad.Tint, &colorSet);
+			if (colorSet)
+				quad.UseTint = false;
+
+			// words are measured on their own, so like rltBuildWrappedText nothing kerns across a space
+			bool space = i < text.size() && text[i] == ' ';
+
+			const rltGlyphInfo* glyph = GetGlyphForCodePoint(text.data(), i, currentPos, fontToUse, scale);
+
+			if (lastGlyph && glyph && !space)
+				currentPos.x += rltGetKerning(fontToUse, lastGlyph->Value, glyph->Value) * scale;
+
+			if (PlaceGlyph(glyph, origin, currentPos, fontToUse, scale, quad.Source, quad.Dest))
+				layout.Quads.push_back(quad);
+
+			lastGlyph = space ? nullptr : glyph;
+		}
+	}
+
+	rltUpdateFontTexture(fontToUse);
+	layout.GlyphCacheGeneration = rltGetGlyphCacheGeneration(fontToUse);
+}
+
+bool rltFontHasCodepoint(rltFont* font, int codepoint)
+{
+	if (!font)
+		return false;
+
+	auto* glyph = rtlGetFontGlyph(font, codepoint);
+
+	return glyph != &font->InvalidGlyph;
+}
+
+bool rltFontHasAllGlyphsInString(rltFont* font, std::string_view text)
+{
+	if (!font)
+		return false;
+
+	Vector2 currentPos = Vector2Zeros;
+
+	for (size_t i = 0; i < text.size();)
+	{
+		ProcessColorSequence(text, i, WHITE);
+		if (i >= text.size())
+			break;
+
+		const auto* glyph = GetGlyphForCodePoint(text.data(), i, currentPos, font, 1);
+
+		if (glyph == &font->InvalidGlyph)
+			return false;
+	}
+	return true;
+}
+
+// bottom left skyline packing, returns the top of the rect if it fits at the start of the node
+static int SkylineFit(const std::vector<rltSkylineNode>& skyline, size_t index, int width, int height, int atlasWidth, int atlasHeight)
+{
+	if (skyline[index].X + width > atlasWidth)
+		return -1;
+
+	int y = 0;
+	int remaining = width;
+	for (size_t i = index; remaining > 0 && i < skyline.size(); i++)
+	{
+		y = std::max(y, skyline[i].Y);
+		if (y + height > atlasHeight)
+			return -1;
+
+		remaining -= skyline[i].Width;
+	}
+
+	return y;
+}
+
+static bool SkylineAllocate(std::vector<rltSkylineNode>& skyline, int width, int height, int atlasWidth, int atlasHeight, int& x, int& y)
+{
+	int bestIndex = -1;
+	int bestBottom = atlasHeight + 1;
+	int bestWidth = atlasWidth + 1;
+
+	for (size_t i = 0; i < skyline.size(); i++)
+	{
+		int top = SkylineFit(skyline, i, width, height, atlasWidth, atlasHeight);
+		if (top < 0)
+			continue;
+
+		// lowest bottom edge wins, the narrowest node breaks ties so wide gaps stay open
+		if (top + height < bestBottom || (top + height == bestBottom && skyline[i].Width < bestWidth))
+		{
+			bestIndex = int(i);
+			bestBottom = top + height;
+			bestWidth = skyline[i].Width;
+			y = top;
+		}
+	}
+
+	if (bestIndex < 0)
+		return false;
+
+	x = skyline[bestIndex].X;
+	skyline.insert(skyline.begin() + bestIndex, rltSkylineNode{ x, y + height, width });
+
+	// trim the nodes the new one now covers
+	for (size_t i = bestIndex + 1; i < skyline.size();)
+	{
+		const rltSkylineNode& previous = skyline[i - 1];
+		rltSkylineNode& node = skyline[i];
+
+		int overlap = previous.X + previous.Width - node.X;
+		if (overlap <= 0)
+			break;
+
+		node.X += overlap;
+		node.Width -= overlap;
+		if (node.Width > 0)
+			break;
+
+		skyline.erase(skyline.begin() + i);
+	}
+
+	for (size_t i = 0; i + 1 < skyline.size();)
+	{
+		if (skyline[i].Y == skyline[i + 1].Y)
+		{
+			skyline[i].Width += skyline[i + 1].Width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	return true;
+}
+
+void rltUpdateFontTexture(const rltFont* font)
+{
+	if (!font || font->AtlasDirtyRect.width <= 0 || font->AtlasDirtyRect.height <= 0 || !font->Atlas.data)
+		return;
+
+	Image changed = ImageFromImage(font->Atlas, font->AtlasDirtyRect);
+	if (changed.data)
+	{
+		Rectangle textureRect = font->AtlasDirtyRect;
+		textureRect.x += font->AtlasOffset.x;
+		textureRect.y += font->AtlasOffset.y;
+
+		UpdateTextureRec(font->Texture, textureRect, changed.data);
+		UnloadImage(changed);
+	}
+
+	font->AtlasDirtyRect = Rectangle{ 0,0,0,0 };
+}
+
+bool rltAddGlpyhToFont(rltFont* font, int codepoint, Image& glpyhImage, const Vector2& offeset, float advance)
+{
+	if (!font || font->Texture.id == 0)
+		return false;
+
+	// fonts that were not rasterized here only get read back once
+	if (!font->Atlas.data)
+	{
+		font->Atlas = LoadImageFromTexture(font->Texture);
+		if (!font->Atlas.data)
+			return false;
+	}
+
+	if (font->Skyline.empty())
+		font->Skyline.push_back(rltSkylineNode{ 0, int(font->LowestSourceRect), font->Atlas.width });
+
+	int padding = int(font->GlyphPadding);
+	int x = 0, y = 0;
+	if (!SkylineAllocate(font->Skyline, glpyhImage.width + padding * 2, glpyhImage.height + padding * 2, font->Atlas.width, font->Atlas.height, x, y))
+		return false;
+
+	rltGlyphInfo newGlyph;
+
+	newGlyph.Value = codepoint;
+	newGlyph.SourceRect = Rectangle{ float(x + padding), float(y + padding), float(glpyhImage.width), float(glpyhImage.height) };
+	newGlyph.DestSize.x = newGlyph.SourceRect.width;
+	newGlyph.DestSize.y = newGlyph.SourceRect.height;
+
+	if (newGlyph.SourceRect.y + newGlyph.SourceRect.height + padding > font->LowestSourceRect)
+		font->LowestSourceRect = newGlyph.SourceRect.y + newGlyph.SourceRect.height + padding;
+
+	newGlyph.Offset = offeset;
+	newGlyph.NextCharacterAdvance = advance;
+	if (newGlyph.NextCharacterAdvance < 0)
+		newGlyph.NextCharacterAdvance = font->DefaultSpacing;
+
+	ImageDraw(&font->Atlas,
+		glpyhImage,
+		Rectangle{ 0,0, float(glpyhImage.width), float(glpyhImage.height) },
+		newGlyph.SourceRect,
+		WHITE);
+
+	// uploaded the next time the font draws, so glyphs added in the same frame go up together
+	font->AtlasDirtyRect = MergeRect(font->AtlasDirtyRect, newGlyph.SourceRect);
+
+	// keep the ranges sorted and contiguous
+	auto next = std::upper_bound(font->Ranges.begin(), font->Ranges.end(), codepoint, CodepointBeforeRange);
+	auto previous = next == font->Ranges.begin() ? font->Ranges.end() : next - 1;
+
+	bool joinsPrevious = previous != font->Ranges.end() && size_t(codepoint) <= previous->Start + previous->Glyphs.size();
+	bool joinsNext = next != font->Ranges.end() && next->Start == size_t(codepoint) + 1;
+
+	if (joinsPrevious && size_t(codepoint) < previous->Start + previous->Glyphs.size())
+	{
+		// replacing a glyph we already have
+		previous->Glyphs[codepoint - previous->Start] = newGlyph;
+	}
+	else if (joinsPrevious)
+	{
+		previous->Glyphs.push_back(newGlyph);
+		if (joinsNext)
+		{
+			previous->Glyphs.insert(previous->Glyphs.end(), next->Glyphs.begin(), next->Glyphs.end());
+			font->Ranges.erase(next);
+		}
+	}
+	else if (joinsNext)
+	{
+		next->Start = codepoint;
+		next->Glyphs.insert(next->Glyphs.begin(), newGlyph);
+	}
+	else
+	{
+		rltGlyphRange range;
+		range.Start = codepoint;
+		range.Glyphs.push_back(newGlyph);
+		font->Ranges.insert(next, range);
+	}
+
+	rltRebuildGlyphLookup(font);
+	return true;
+}
+
+// shared atlas pages
+
+bool rltAddFontToAtlasPages(rltFont* font, rltAtlasPages& pages)
+{
+	if (!font || font == &DefaultFont || font->SharedTexture || font->Texture.id == 0)
+		return false;
+
+	if (!font->Atlas.data)
+	{
+		font->Atlas = LoadImageFromTexture(font->Texture);
+		if (!font->Atlas.data)
+			return false;
+	}
+
+	// everything below the lowest glyph is padding from rounding the atlas up
+	int width = font->Atlas.width;
+	int height = std::min(font->Atlas.height, int(ceilf(font->LowestSourceRect)));
+	if (height <= 0)
+		return false;
+
+	rltUpdateFontTexture(font);
+
+	// pages made before a size change keep their own size
+	int x = 0, y = 0;
+	rltAtlasPage* page = nullptr;
+	for (auto& candidate : pages.Pages)
+	{
+		if (candidate.Texture.format != font->Atlas.format || candidate.SDF != font->SDF)
+			continue;
+
+		if (SkylineAllocate(candidate.Skyline, width, height, candidate.Texture.width, candidate.Texture.height, x, y))
+		{
+			page = &candidate;
+			break;
+		}
+	}
+
+	if (!page)
+	{
+		if (width > pages.PageSize || height > pages.PageSize)
+			return false;
+
+		Image blank = { 0 };
+		blank.width = pages.PageSize;
+		blank.height = pages.PageSize;
+		blank.mipmaps = 1;
+		blank.format = font->Atlas.format;
+
+		int blankSize = GetPixelDataSize(blank.width, blank.height, blank.format);
+		blank.data = MemAlloc(blankSize);
+		memset(blank.data, 0, blankSize);
+
+		rltAtlasPage newPage;
+		newPage.Texture = LoadTextureFromImage(blank);
+		newPage.SDF = font->SDF;
+		newPage.Skyline.push_back(rltSkylineNode{ 0, 0, pages.PageSize });
+		UnloadImage(blank);
+
+		if (newPage.Texture.id == 0)
+			return false;
+
+		if (newPage.SDF)
+			SetTextureFilter(newPage.Texture, TEXTURE_FILTER_BILINEAR);
+
+		pages.Pages.push_back(newPage);
+		page = &pages.Pages.back();
+		SkylineAllocate(page->Skyline, width, height, pages.PageSize, pages.PageSize, x, y);
+	}
+
+	if (height < font->Atlas.height)
+		ImageCrop(&font->Atlas, Rectangle{ 0, 0, float(width), float(height) });
+
+	UpdateTextureRec(page->Texture, Rectangle{ float(x), float(y), float(width), float(height) }, font->Atlas.data);
+
+	UnloadTexture(font->Texture);
+	font->Texture = page->Texture;
+	font->AtlasOffset = Vector2{ float(x), float(y) };
+	font->SharedTexture = true;
+
+	// the trimmed atlas has no room left for the skyline to hand out
+	font->LowestSourceRect = float(font->Atlas.height);
+	font->Skyline.clear();
+
+	return true;
+}
+
+void rltUnloadAtlasPages(rltAtlasPages& pages)
+{
+	for (auto& page : pages.Pages)
+		UnloadTexture(page.Texture);
+
+	pages.Pages.clear();
+}
+
+// font cache files
+
+static constexpr char FontCacheMagic[4] = { 'R','L','T','F' };
+static constexpr uint32_t FontCacheVersion = 5;
+
+struct FontCacheHeader
+{
+	char Magic[4] = { 0 };
+	uint32_t Version = 0;
+	uint32_t GlyphInfoSize = 0;
+
+	rltFontCacheKey Key;
+
+	float BaseSize = 0;
+	float GlyphPadding = 0;
+	float DefaultSpacing = 0;
+	float DefaultNewlineOffset = 0;
+	float Accent = 0;
+	float AtlasFillRatio = 0;
+	float LowestSourceRect = 0;
+	rltGlyphInfo InvalidGlyph;
+
+	uint32_t RangeCount = 0;
+	uint32_t KerningCount = 0;
+
+	int32_t AtlasWidth = 0;
+	int32_t AtlasHeight = 0;
+	int32_t AtlasFormat = 0;
+	uint32_t AtlasDataSize = 0;
+};
+
+struct FontCacheRange
+{
+	uint32_t Start = 0;
+	uint32_t GlyphCount = 0;
+};
+
+static bool KeysMatch(const rltFontCacheKey& a, const rltFontCacheKey& b)
+{
+	return a.FileHash == b.FileHash && a.Size == b.Size && a.GlyphSetHash == b.GlyphSetHash && a.RasterScale == b.RasterScale && a.SDF == b.SDF && a.SingleChannel == b.SingleChannel
+		&& a.PowerOfTwoAtlas == b.PowerOfTwoAtlas && a.MaxAtlasSize == b.MaxAtlasSize && a.DefaultSpacing == b.DefaultSpacing;
+}
+
+template<class T>
+static void AppendBytes(std::vector<unsigned char>& buffer, const T* data, size_t count)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T) * count);
+}
+
+template<class T>
+static bool ReadBytes(const unsigned char* buffer, size_t bufferSize, size_t& offset, T* data, size_t count)
+{
+	size_t size = sizeof(T) * count;
+	if (offset + size > bufferSize)
+		return false;
+
+	memcpy(data, buffer + offset, size);
+	offset += size;
+	return true;
+}
+
+bool rltSaveFontCache(const rltFont* font, const rltFontCacheKey& key, std::string_view filePath)
+{
+	if (!font || font->Ranges.empty() || font->Texture.id == 0)
+		return false;
+
+	rltUpdateFontTexture(font);
+
+	bool readBack = !font->Atlas.data;
+	Image atlas = readBack ? LoadImageFromTexture(font->Texture) : font->Atlas;
+	if (!atlas.data)
+		return false;
+
+	FontCacheHeader header;
+	memcpy(header.Magic, FontCacheMagic, sizeof(FontCacheMagic));
+	header.Version = FontCacheVersion;
+	header.GlyphInfoSize = uint32_t(sizeof(rltGlyphInfo));
+	header.Key = key;
+	header.BaseSize = font->BaseSize;
+	header.GlyphPadding = font->GlyphPadding;
+	header.DefaultSpacing = font->DefaultSpacing;
+	header.DefaultNewlineOffset = font->DefaultNewlineOffset;
+	header.Accent = font->Accent;
+	header.AtlasFillRatio = font->AtlasFillRatio;
+	header.LowestSourceRect = font->LowestSourceRect;
+	header.InvalidGlyph = font->InvalidGlyph;
+	header.RangeCount = uint32_t(font->Ranges.size());
+	header.KerningCount = uint32_t(font->Kerning.Pairs.size());
+	header.AtlasWidth = atlas.width;
+	header.AtlasHeight = atlas.height;
+	header.AtlasFormat = atlas.format;
+	header.AtlasDataSize = uint32_t(GetPixelDataSize(atlas.width, atlas.height, atlas.format));
+
+	std::vector<unsigned char> buffer;
+	AppendBytes(buffer, &header, 1);
+
+	for (const auto& range : font->Ranges)
+	{
+		FontCacheRange cacheRange{ uint32_t(range.Start), uint32_t(range.Glyphs.size()) };
+		AppendBytes(buffer, &cacheRange, 1);
+		AppendBytes(buffer, range.Glyphs.data(), range.Glyphs.size());
+	}
+
+	AppendBytes(buffer, font->Kerning.Pairs.data(), font->Kerning.Pairs.size());
+	AppendBytes(buffer, (const unsigned char*)atlas.data, header.AtlasDataSize);
+
+	if (readBack)
+		UnloadImage(atlas);
+
+	return SaveFileData(filePath.data(), buffer.data(), int(buffer.size()));
+}
+
+bool rltLoadFontCache(rltFont* font, const rltFontCacheKey& key, std::string_view filePath)
+{
+	if (!font || !FileExists(filePath.data()))
+		return false;
+
+	int dataSize = 0;
+	unsigned char* fileData = LoadFileData(filePath.data(), &dataSize);
+	if (!fileData)
+		return false;
+
+	size_t size = size_t(dataSize);
+	size_t offset = 0;
+
+	rltFont loaded;
+	std::vector<rltKerningPair> kerningPairs;
+
+	FontCacheHeader header;
+	bool valid = ReadBytes(fileData, size, offset, &header, 1)
+		&& memcmp(header.Magic, FontCacheMagic, sizeof(FontCacheMagic)) == 0
+		&& header.Version == FontCacheVersion
+		&& header.GlyphInfoSize == sizeof(rltGlyphInfo)
+		&& KeysMatch(header.Key, key);
+
+	for (uint32_t i = 0; valid && i < header.RangeCount; i++)
+	{
+		FontCacheRange cacheRange;
+		valid = ReadBytes(fileData, size, offset, &cacheRange, 1);
+		if (!valid)
+			break;
+
+		// don't trust a count the file can't hold
+		valid = size_t(cacheRange.GlyphCount) * sizeof(rltGlyphInfo) <= size - offset;
+		if (!valid)
+			break;
+
+		auto& range = loaded.Ranges.emplace_back();
+		range.Start = cacheRange.Start;
+		range.Glyphs.resize(cacheRange.GlyphCount);
+		valid = ReadBytes(fileData, size, offset, range.Glyphs.data(), range.Glyphs.size());
+	}
+
+	if (valid && size_t(header.KerningCount) * sizeof(rltKerningPair) <= size - offset)
+	{
+		kerningPairs.resize(header.KerningCount);
+		valid = ReadBytes(fileData, size, offset, kerningPairs.data(), kerningPairs.size());
+	}
+	else
+	{
+		valid = false;
+	}
+
+	valid = valid && offset + header.AtlasDataSize <= size
+		&& header.AtlasDataSize == uint32_t(GetPixelDataSize(header.AtlasWidth, header.AtlasHeight, header.AtlasFormat));
+
+	if (valid)
+	{
+		Image atlas = { fileData + offset, header.AtlasWidth, header.AtlasHeight, 1, header.AtlasFormat };
+		loaded.Atlas = ImageCopy(atlas);
+		loaded.Texture = LoadTextureFromImage(loaded.Atlas);
+
+		loaded.SDF = header.Key.SDF;
+		if (loaded.SDF)
+			SetTextureFilter(loaded.Texture, TEXTURE_FILTER_BILINEAR);
+
+		loaded.BaseSize = header.BaseSize;
+		loaded.GlyphPadding = header.GlyphPadding;
+		loaded.DefaultSpacing = header.DefaultSpacing;
+		loaded.DefaultNewlineOffset = header.DefaultNewlineOffset;
+		loaded.Accent = header.Accent;
+		loaded.AtlasFillRatio = header.AtlasFillRatio;
+		loaded.LowestSourceRect = header.LowestSourceRect;
+		loaded.InvalidGlyph = header.InvalidGlyph;
+
+		rltSetFontKerning(&loaded, kerningPairs);
+		rltRebuildGlyphLookup(&loaded);
+
+		*font = std::move(loaded);
+	}
+
+	UnloadFileData(fileData);
+
+	return valid;
+}